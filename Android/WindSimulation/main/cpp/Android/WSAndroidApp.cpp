@@ -21,23 +21,27 @@ namespace WindSim
 
 		void App::onReshape(int width, int height)
 		{
-			const float hWidth = static_cast<float>(width) / 2.0f;
-			const float hHeight = static_cast<float>(height) / 2.0f;
-
 			getStage()->resize(width, height);
 
 			getStage()->setProjectionMatrix(
-					Nova::Math::MatrixUtil::ortho(-hWidth, hWidth, -hHeight, hHeight, 1, 2)
+					MatrixUtil::perspective(45, static_cast<float>(width) / static_cast<float>(height), 1, 150)
 			);
 		}
 
+
 		void App::onStart()
 		{
+			const float rads = 90.0f * static_cast<float>(M_PI) / 180.0f;
+
+			// Same view as the desktop version
 			getStage()->setViewMatrix(
-					Nova::Math::MatrixUtil::view(0, 0, 1, 0, 0, 0, 0, 1, 0)
+					MatrixUtil::view(
+						50.0f * cosf(rads), 25, 50.0f * sinf(rads),
+						0, 0, 0,
+						0, 1, 0)
 			);
 
-			getStage()->setBaseColour(Nova::Colour::BLACK);
+			getStage()->setBaseColour(Colour::BLACK);
 
 			getTimer().start();
 		}
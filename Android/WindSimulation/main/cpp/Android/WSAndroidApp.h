@@ -15,7 +15,8 @@ namespace WindSim
 		/**
 		 * Android version of the Wind Simulation app.
 		 * 
-		 * Handles the Stage/Scene, as well as App's resources
+		 * Handles the Stage, as well as App's resources.  The Scene itself is
+		 * shared with the desktop version.
 		 */
 		class App : public Nova::Android::App
 		{
@@ -23,10 +24,11 @@ namespace WindSim
 			App(JNIEnv* env, jobject assets);
 
 		protected:
-			
+
 			/**
-			 * Handle a window reshape event
-			 * 
+			 * Handle a window reshape event, with the same projection as the
+			 * desktop version
+			 *
 			 * @param width : New width of the window
 			 * @param height : New height of the window
 			 */
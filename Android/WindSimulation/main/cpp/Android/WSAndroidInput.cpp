@@ -8,7 +8,6 @@
 
 using Nova::Input_p;
 using Nova::Event;
-using Nova::Math::Vector;
 using Nova::Math::VectorUtil;
 
 namespace WindSim
@@ -17,48 +16,56 @@ namespace WindSim
 	/**
 	 * Handles the input from the user.
 	 *
-	 * This version handles input from a Joystick, and sets the wind
-	 * direction and power based on the direction the joystick is moved in
-	 * (relative to the origin), and the amount it has moved in that direction.
+	 * This version handles input from a Joystick.  It only keeps the newest
+	 * position, for applyInput() to steer the wind with once all of this
+	 * frame's events have been read.
 	 *
 	 * @param event The latest Input Event received from the user.
+	 *
+	 * @return true if the event was used
 	 */
-	void Scene::handleInput(Input_p event)
+	bool Scene::handleInput(const Input_p& event)
 	{
 		// If no event received, skip function
-		if (event == nullptr)
-			return;
+		if (event == nullptr || simulation == nullptr)
+			return false;
 
 		// If event is not a Joystick Input, return
 		if (event->getInputType() != Event::Input::JOYSTICK)
-			return;
+			return false;
 
 		// If event is not a joystick moved event, return
 		if (!event->isActive())
-			return;
+			return false;
 
 		// Cast to Joystick Input event
-		Event::JoystickInput* input = (Event::JoystickInput*)(event.get());
+		auto input = static_cast<Event::JoystickInput*>(event.get());
 
-		Vector position = input->getPosition();
+		joystick = input->getPosition();
+		joystickMoved = true;
 
-		// Calculate the angle of the emitter based on the joystick's position relative
-		// to its origin.
-		emitterAngle = static_cast<float>((atan2f(position.y, position.x)) * (180.0f / M_PI)) + 90.0f;
+		return true;
+	}
 
-		// Calculate the wind power based on distance from the origin
-		power = VectorUtil::magnitude(position) / 100.0f;
 
-		// Force power to stay within 0 and 1
-		if (power < 0.0f)
-			power = 0.0f;
+	/**
+	 * Points the wind in the direction the joystick was last moved in (relative
+	 * to the origin), with a power based on the amount it has moved in that
+	 * direction.
+	 */
+	void Scene::applyInput()
+	{
+		if (!joystickMoved || simulation == nullptr)
+			return;
 
-		if (power > 1.0f)
-			power = 1.0f;
+		joystickMoved = false;
 
-		// Request an emitter update.
-		eUpdate = true;
+		// Calculate the angle of the emitter based on the joystick's position relative
+		// to its origin, and the wind power based on the distance from it
+		const float angle = static_cast<float>((atan2f(joystick.y, joystick.x)) * (180.0f / M_PI)) + 90.0f;
+		const float distance = VectorUtil::magnitude(joystick) / 100.0f;
+
+		simulation->setSteering(angle, distance);
 	}
 
 }
-
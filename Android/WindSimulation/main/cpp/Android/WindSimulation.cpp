@@ -41,9 +41,8 @@ Java_com_nova_windsimulation_WindSimActivity_novaInitialise(JNIEnv* env, jobject
 
 	Nova::App::open(app, settings);
 
-	Nova::App::openScene(DBG_NEW WindSim::FinalScene());
-
-	Nova::App::start();
+	// Same scene and defaults as the desktop version, with a new seed each run
+	WindSim::FinalScene::start(WindSim::LaunchSettings());
 }
 
 }
\ No newline at end of file
@@ -81,7 +81,8 @@ public:
 	void Import();
 
 	/**
-	 *	Loads a map package into memory
+	 *	Loads a map package into memory.  Packages with the .bomz extension hold
+		run-length encoded rows, as written by the RandomDungeonGenerator.
 
 	 *	@param filename : Path and name of the package file to load
 
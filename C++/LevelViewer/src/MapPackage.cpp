@@ -144,15 +144,36 @@ bool MapPackage::LoadPackage(const string filename)
 
 	assert(numcolumns * numrows > 0);
 
-	layout = new char*[numrows];
+	// Rows start empty, so Release() is safe if a compressed row turns out bad
+	layout = new char*[numrows]();
 
 	assert(layout);
 
+	// .bomz packages store each row as pairs of a count and a character
+	const bool compressed = filename.find(".bomz") != string::npos;
+
 	for (unsigned int i = 0; i < numrows; i++)
 	{
 		layout[i] = new char[numcolumns];
 
-		stream.read(layout[i], numcolumns);
+		if (!compressed)
+		{
+			stream.read(layout[i], numcolumns);
+			continue;
+		}
+
+		for (unsigned long j = 0; j < numcolumns; )
+		{
+			unsigned char run[2];
+
+			stream.read((char*)run, 2);
+
+			if (!stream || run[0] == 0 || j + run[0] > numcolumns)
+				throw runtime_error("MAP ERROR : Bad row in compressed map : " + filename);
+
+			memset(layout[i] + j, run[1], run[0]);
+			j += run[0];
+		}
 	}
 
 	stream.close();
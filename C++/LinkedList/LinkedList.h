@@ -11,7 +11,11 @@
 
 #pragma once
 
+#include <cassert>
 #include <memory>
+#include <new>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
@@ -241,10 +245,11 @@ public:
 			return;
 
 		LinkedListNode<T>* tmp = last;
-		LinkedListNode<T>* nextone = last->prevnode;
 
 		while(tmp != nullptr)
 		{
+			LinkedListNode<T>* nextone = tmp->prevnode;
+
 			delete tmp;
 
 			tmp = nextone;
@@ -354,3 +359,604 @@ protected:
 	LinkedListNode<T>* last;
 };
 
+
+/**
+ *	Node of a PooledLinkedList.  The item is held by value, in storage which is
+ *	only constructed while the node is in a list.
+ */
+template <class T>
+class PooledLinkedListNode
+{
+public:
+	PooledLinkedListNode<T>* nextNode()
+	{
+		return nextnode;
+	}
+
+	PooledLinkedListNode<T>* prevNode()
+	{
+		return prevnode;
+	}
+
+	T& getNodeItem()
+	{
+		return *reinterpret_cast<T*>(&storage);
+	}
+
+protected:
+	template <class U> friend class LinkedListPool;
+	template <class U> friend class PooledLinkedList;
+
+	PooledLinkedListNode<T>* prevnode;
+	PooledLinkedListNode<T>* nextnode;
+	alignas(T) unsigned char storage[sizeof(T)];
+};
+
+/**
+ *	Slab allocator for PooledLinkedList nodes.  Nodes are allocated a slab at a
+ *	time, and released nodes go on a free list to be handed out again, so a
+ *	list only touches the heap when it grows past every node it has had before.
+ *
+ *	A pool can be shared by several lists of the same type.  It must outlive
+ *	them, and is not thread safe.
+ */
+template <class T>
+class LinkedListPool
+{
+public:
+	LinkedListPool(unsigned int slabsize = 64)
+	{
+		assert(slabsize > 0);
+
+		this->slabsize = slabsize;
+
+		freenodes = nullptr;
+		nodecount = 0;
+	}
+
+	LinkedListPool(const LinkedListPool<T>&) = delete;
+	LinkedListPool<T>& operator =(const LinkedListPool<T>&) = delete;
+
+	/**
+	 *	Make sure at least count nodes are free, without any more allocations
+	 */
+	void reserve(size_t count)
+	{
+		size_t available = 0;
+
+		for(PooledLinkedListNode<T>* node = freenodes; node != nullptr && available < count; node = node->nextnode)
+			available++;
+
+		while(available < count)
+		{
+			addSlab();
+
+			available += slabsize;
+		}
+	}
+
+	/**
+	 *	Number of nodes allocated, free or not
+	 */
+	size_t capacity() const
+	{
+		return nodecount;
+	}
+
+	PooledLinkedListNode<T>* allocate()
+	{
+		if(freenodes == nullptr)
+			addSlab();
+
+		PooledLinkedListNode<T>* node = freenodes;
+
+		freenodes = node->nextnode;
+
+		return node;
+	}
+
+	/**
+	 *	Return a node, whose item has already been destroyed, to the free list
+	 */
+	void release(PooledLinkedListNode<T>* node)
+	{
+		node->prevnode = nullptr;
+		node->nextnode = freenodes;
+
+		freenodes = node;
+	}
+
+protected:
+	void addSlab()
+	{
+		PooledLinkedListNode<T>* slab = new PooledLinkedListNode<T>[slabsize];
+		assert(slab);
+
+		slabs.emplace_back(slab);
+
+		// Threaded onto the free list in order, so a new list walks its nodes
+		// through memory front to back
+		for(unsigned int i = slabsize; i > 0; i--)
+			release(&slab[i - 1]);
+
+		nodecount += slabsize;
+	}
+
+	vector<unique_ptr<PooledLinkedListNode<T>[]>> slabs;
+	PooledLinkedListNode<T>* freenodes;
+	unsigned int slabsize;
+	size_t nodecount;
+};
+
+template <class T>
+class PooledLinkedListIter
+{
+public:
+	PooledLinkedListIter(PooledLinkedListNode<T>* node = nullptr)
+	{
+		curnode = node;
+	}
+
+	bool operator ==(const PooledLinkedListIter<T>& orig) const
+	{
+		return orig.curnode == curnode;
+	}
+
+	bool operator !=(const PooledLinkedListIter<T>& orig) const
+	{
+		return orig.curnode != curnode;
+	}
+
+	T& operator *() const
+	{
+		assert(curnode);
+
+		return curnode->getNodeItem();
+	}
+
+	T* operator ->() const
+	{
+		assert(curnode);
+
+		return &curnode->getNodeItem();
+	}
+
+	PooledLinkedListIter<T>& operator ++()
+	{
+		if(curnode)
+			curnode = curnode->nextNode();
+
+		return *this;
+	}
+
+	PooledLinkedListIter<T> operator ++(int)
+	{
+		PooledLinkedListIter<T> ret = *this;
+
+		++(*this);
+
+		return ret;
+	}
+
+	PooledLinkedListIter<T>& operator --()
+	{
+		if(curnode)
+			curnode = curnode->prevNode();
+
+		return *this;
+	}
+
+protected:
+	template <class U> friend class PooledLinkedList;
+	PooledLinkedListNode<T>* curnode;
+};
+
+/**
+ *	Doubly linked list holding its items by value, with nodes taken from a
+ *	LinkedListPool rather than allocated one at a time.
+ *
+ *	Items are moved or constructed in place, and removed in O(1) through an
+ *	iterator.  Once the pool holds enough nodes, adding and removing entries
+ *	does no heap allocation.  Iterators stay valid until their own entry is
+ *	removed.
+ */
+template <class T>
+class PooledLinkedList
+{
+public:
+	typedef PooledLinkedListIter<T> iterator;
+
+	/**
+	 *	@param pool : Pool to share with other lists, or nullptr for the list
+	 *	to have its own
+	 */
+	PooledLinkedList(LinkedListPool<T>* pool = nullptr)
+	{
+		if(pool == nullptr)
+		{
+			ownpool.reset(new LinkedListPool<T>());
+			assert(ownpool);
+
+			pool = ownpool.get();
+		}
+
+		this->pool = pool;
+
+		listlength = 0;
+
+		first = last = nullptr;
+	}
+
+	PooledLinkedList(const PooledLinkedList<T>&) = delete;
+	PooledLinkedList<T>& operator =(const PooledLinkedList<T>&) = delete;
+
+	~PooledLinkedList()
+	{
+		removeAllEntries();
+	}
+
+	iterator addEntry(const T& newentry)
+	{
+		return emplaceEntry(newentry);
+	}
+
+	iterator addEntry(T&& newentry)
+	{
+		return emplaceEntry(std::move(newentry));
+	}
+
+	/**
+	 *	Construct a new entry at the end of the list
+	 */
+	template <class... Args>
+	iterator emplaceEntry(Args&&... args)
+	{
+		PooledLinkedListNode<T>* newnode = pool->allocate();
+
+		new (&newnode->storage) T(std::forward<Args>(args)...);
+
+		newnode->prevnode = last;
+		newnode->nextnode = nullptr;
+
+		if(last != nullptr)
+			last->nextnode = newnode;
+		else
+			first = newnode;
+
+		last = newnode;
+		listlength++;
+
+		return iterator(newnode);
+	}
+
+	/**
+	 *	Remove an entry in O(1)
+	 *
+	 *	@return an iterator to the entry after it
+	 */
+	iterator removeEntry(iterator entry)
+	{
+		PooledLinkedListNode<T>* curnode = entry.curnode;
+
+		assert(curnode);
+
+		PooledLinkedListNode<T>* nextone = curnode->nextnode;
+
+		if(curnode->prevnode != nullptr)
+			curnode->prevnode->nextnode = nextone;
+		else
+			first = nextone;
+
+		if(nextone != nullptr)
+			nextone->prevnode = curnode->prevnode;
+		else
+			last = curnode->prevnode;
+
+		curnode->getNodeItem().~T();
+		pool->release(curnode);
+
+		listlength--;
+
+		return iterator(nextone);
+	}
+
+	void removeAllEntries()
+	{
+		PooledLinkedListNode<T>* tmp = first;
+
+		while(tmp != nullptr)
+		{
+			PooledLinkedListNode<T>* nextone = tmp->nextnode;
+
+			tmp->getNodeItem().~T();
+			pool->release(tmp);
+
+			tmp = nextone;
+		}
+
+		listlength = 0;
+
+		last = first = nullptr;
+	}
+
+	int length() const
+	{
+		return listlength;
+	}
+
+	iterator start()
+	{
+		return iterator(first);
+	}
+
+	iterator begin()
+	{
+		return iterator(first);
+	}
+
+	iterator end()
+	{
+		return iterator();
+	}
+
+protected:
+	unique_ptr<LinkedListPool<T>> ownpool;
+	LinkedListPool<T>* pool;
+
+	int listlength;
+
+	PooledLinkedListNode<T>* first;
+	PooledLinkedListNode<T>* last;
+};
+
+template <class T>
+class IntrusiveLinkedList;
+
+/**
+ *	Links for an IntrusiveLinkedList.  Items derive from it, passing their own
+ *	type (class Item : public IntrusiveLinkedListHook<Item>), and can be in one
+ *	such list at a time.
+ */
+template <class T>
+class IntrusiveLinkedListHook
+{
+public:
+	IntrusiveLinkedListHook()
+	{
+		prevnode = nextnode = nullptr;
+		linked = false;
+	}
+
+	// Links belong to the object, not its value
+	IntrusiveLinkedListHook(const IntrusiveLinkedListHook<T>&)
+	{
+		prevnode = nextnode = nullptr;
+		linked = false;
+	}
+
+	IntrusiveLinkedListHook<T>& operator =(const IntrusiveLinkedListHook<T>&)
+	{
+		return *this;
+	}
+
+	~IntrusiveLinkedListHook()
+	{
+		assert(!linked);
+	}
+
+	bool isLinked() const
+	{
+		return linked;
+	}
+
+	T* nextNode()
+	{
+		return nextnode;
+	}
+
+	T* prevNode()
+	{
+		return prevnode;
+	}
+
+protected:
+	friend class IntrusiveLinkedList<T>;
+
+	T* prevnode;
+	T* nextnode;
+	bool linked;
+};
+
+template <class T>
+class IntrusiveLinkedListIter
+{
+public:
+	IntrusiveLinkedListIter(T* node = nullptr)
+	{
+		curnode = node;
+	}
+
+	bool operator ==(const IntrusiveLinkedListIter<T>& orig) const
+	{
+		return orig.curnode == curnode;
+	}
+
+	bool operator !=(const IntrusiveLinkedListIter<T>& orig) const
+	{
+		return orig.curnode != curnode;
+	}
+
+	T& operator *() const
+	{
+		assert(curnode);
+
+		return *curnode;
+	}
+
+	T* operator ->() const
+	{
+		assert(curnode);
+
+		return curnode;
+	}
+
+	IntrusiveLinkedListIter<T>& operator ++()
+	{
+		if(curnode)
+			curnode = curnode->nextNode();
+
+		return *this;
+	}
+
+	IntrusiveLinkedListIter<T> operator ++(int)
+	{
+		IntrusiveLinkedListIter<T> ret = *this;
+
+		++(*this);
+
+		return ret;
+	}
+
+	IntrusiveLinkedListIter<T>& operator --()
+	{
+		if(curnode)
+			curnode = curnode->prevNode();
+
+		return *this;
+	}
+
+protected:
+	T* curnode;
+};
+
+/**
+ *	Doubly linked list of items which hold their own links, through
+ *	IntrusiveLinkedListHook.  The list does not own or allocate anything, so
+ *	adding and removing entries never touches the heap, and an item can be
+ *	removed in O(1) from the item alone.
+ *
+ *	Items must be removed, or the list emptied, before they are destroyed.
+ */
+template <class T>
+class IntrusiveLinkedList
+{
+public:
+	typedef IntrusiveLinkedListIter<T> iterator;
+
+	IntrusiveLinkedList()
+	{
+		listlength = 0;
+
+		first = last = nullptr;
+	}
+
+	IntrusiveLinkedList(const IntrusiveLinkedList<T>&) = delete;
+	IntrusiveLinkedList<T>& operator =(const IntrusiveLinkedList<T>&) = delete;
+
+	~IntrusiveLinkedList()
+	{
+		removeAllEntries();
+	}
+
+	iterator addEntry(T& newentry)
+	{
+		IntrusiveLinkedListHook<T>& hook = newentry;
+
+		assert(!hook.linked);
+
+		hook.prevnode = last;
+		hook.nextnode = nullptr;
+		hook.linked = true;
+
+		if(last != nullptr)
+			static_cast<IntrusiveLinkedListHook<T>*>(last)->nextnode = &newentry;
+		else
+			first = &newentry;
+
+		last = &newentry;
+		listlength++;
+
+		return iterator(&newentry);
+	}
+
+	/**
+	 *	Unlink an item in O(1).  It must be in this list.
+	 *
+	 *	@return an iterator to the entry after it
+	 */
+	iterator removeEntry(T& entry)
+	{
+		IntrusiveLinkedListHook<T>& hook = entry;
+
+		assert(hook.linked);
+
+		T* nextone = hook.nextnode;
+
+		if(hook.prevnode != nullptr)
+			static_cast<IntrusiveLinkedListHook<T>*>(hook.prevnode)->nextnode = nextone;
+		else
+			first = nextone;
+
+		if(nextone != nullptr)
+			static_cast<IntrusiveLinkedListHook<T>*>(nextone)->prevnode = hook.prevnode;
+		else
+			last = hook.prevnode;
+
+		hook.prevnode = hook.nextnode = nullptr;
+		hook.linked = false;
+
+		listlength--;
+
+		return iterator(nextone);
+	}
+
+	iterator removeEntry(iterator entry)
+	{
+		return removeEntry(*entry);
+	}
+
+	void removeAllEntries()
+	{
+		T* tmp = first;
+
+		while(tmp != nullptr)
+		{
+			IntrusiveLinkedListHook<T>& hook = *tmp;
+
+			tmp = hook.nextnode;
+
+			hook.prevnode = hook.nextnode = nullptr;
+			hook.linked = false;
+		}
+
+		listlength = 0;
+
+		last = first = nullptr;
+	}
+
+	int length() const
+	{
+		return listlength;
+	}
+
+	iterator start()
+	{
+		return iterator(first);
+	}
+
+	iterator begin()
+	{
+		return iterator(first);
+	}
+
+	iterator end()
+	{
+		return iterator();
+	}
+
+protected:
+	int listlength;
+
+	T* first;
+	T* last;
+};
@@ -0,0 +1,237 @@
+/*
+ *	LinkedListBenchmark.cpp by Chris Allen
+
+ *	This file is provided "as-is", for the sole purpose of a demonstration of my
+	work.  It is not intended to be copied or used in an external or third-party
+	project, and no support will be given for that use.
+
+ *	You may not use or copy this file, in whole or in part, to use for your own
+	projects.  All rights reserved over this file.
+ */
+
+/*
+ *	Times LinkedList, PooledLinkedList and IntrusiveLinkedList against std::list
+ *	and std::vector on the same churn: fill a list, walk it, then remove every
+ *	other entry and refill it, over and over.  Also counts the heap allocations
+ *	each one makes after its first round, once any pool has grown to size.
+ *
+ *	Build with optimisations, e.g.
+ *		g++ -std=c++14 -O2 LinkedListBenchmark.cpp -o LinkedListBenchmark
+ *
+ *	LinkedList has no way to remove an entry while walking it, and removeEntry
+ *	is O(n), so its rounds empty and refill the whole list instead.
+ */
+
+#include "LinkedList.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+static atomic<size_t> allocations(0);
+
+void* operator new(size_t size)
+{
+	allocations++;
+
+	if(void* ret = malloc(size > 0 ? size : 1))
+		return ret;
+
+	throw bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+struct Particle
+{
+	float x, y, vx, vy;
+	int id;
+
+	Particle(int id = 0)
+	{
+		this->id = id;
+
+		x = y = 0.0f;
+		vx = vy = 1.0f;
+	}
+};
+
+struct HookedParticle : public Particle, public IntrusiveLinkedListHook<HookedParticle>
+{
+	HookedParticle(int id = 0) : Particle(id)
+	{
+	}
+};
+
+static const int ITEMS = 10000;
+static const int ROUNDS = 200;
+
+/**
+ *	Time a benchmark's rounds, and count the allocations after the first
+ */
+template <class Round>
+static void run(const char* name, Round round)
+{
+	round(0);
+
+	const size_t before = allocations;
+	const auto started = chrono::steady_clock::now();
+
+	long long checksum = 0;
+
+	for(int i = 1; i <= ROUNDS; i++)
+		checksum += round(i);
+
+	const double millis = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+
+	printf("%-22s %10.3f %14.1f %12lld\n", name, millis / ROUNDS,
+		static_cast<double>(allocations - before) / ROUNDS, checksum);
+}
+
+/**
+ *	Move every entry, and sum their ids so the work isn't optimised out
+ */
+template <class List>
+static long long walk(List& list)
+{
+	long long ret = 0;
+
+	for(auto& item : list)
+	{
+		item.x += item.vx;
+		item.y += item.vy;
+
+		ret += item.id;
+	}
+
+	return ret;
+}
+
+int main()
+{
+	printf("%d items, %d rounds\n\n", ITEMS, ROUNDS);
+	printf("%-22s %10s %14s %12s\n", "list", "ms/round", "allocs/round", "checksum");
+
+	{
+		LinkedList<Particle> entries;
+
+		run("LinkedList", [&](int)
+		{
+			long long ret = 0;
+
+			entries.removeAllEntries();
+
+			for(int i = 0; i < ITEMS; i++)
+				entries.addEntry(make_shared<Particle>(i));
+
+			for(LinkedListIter<Particle> iter = entries.start(); iter != nullptr; iter++)
+			{
+				shared_ptr<Particle> item = *iter;
+
+				item->x += item->vx;
+				item->y += item->vy;
+
+				ret += item->id;
+			}
+
+			return ret;
+		});
+	}
+
+	{
+		list<Particle> entries;
+
+		run("std::list", [&](int)
+		{
+			while(static_cast<int>(entries.size()) < ITEMS)
+				entries.emplace_back(static_cast<int>(entries.size()));
+
+			const long long ret = walk(entries);
+
+			bool odd = false;
+
+			for(auto iter = entries.begin(); iter != entries.end(); odd = !odd)
+				iter = odd ? entries.erase(iter) : next(iter);
+
+			return ret;
+		});
+	}
+
+	{
+		vector<Particle> entries;
+
+		run("std::vector", [&](int)
+		{
+			while(static_cast<int>(entries.size()) < ITEMS)
+				entries.emplace_back(static_cast<int>(entries.size()));
+
+			const long long ret = walk(entries);
+
+			bool odd = false;
+
+			entries.erase(remove_if(entries.begin(), entries.end(), [&](const Particle&) { odd = !odd; return !odd; }), entries.end());
+
+			return ret;
+		});
+	}
+
+	{
+		PooledLinkedList<Particle> entries;
+
+		run("PooledLinkedList", [&](int)
+		{
+			while(entries.length() < ITEMS)
+				entries.emplaceEntry(entries.length());
+
+			const long long ret = walk(entries);
+
+			bool odd = false;
+
+			for(auto iter = entries.begin(); iter != entries.end(); odd = !odd)
+				iter = odd ? entries.removeEntry(iter) : ++iter;
+
+			return ret;
+		});
+	}
+
+	{
+		vector<HookedParticle> items(ITEMS);
+		IntrusiveLinkedList<HookedParticle> entries;
+
+		for(int i = 0; i < ITEMS; i++)
+			items[i].id = i;
+
+		run("IntrusiveLinkedList", [&](int)
+		{
+			for(HookedParticle& item : items)
+			{
+				if(!item.isLinked())
+					entries.addEntry(item);
+			}
+
+			const long long ret = walk(entries);
+
+			bool odd = false;
+
+			for(auto iter = entries.begin(); iter != entries.end(); odd = !odd)
+				iter = odd ? entries.removeEntry(iter) : ++iter;
+
+			return ret;
+		});
+
+		entries.removeAllEntries();
+	}
+
+	return 0;
+}
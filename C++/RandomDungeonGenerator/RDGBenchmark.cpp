@@ -0,0 +1,264 @@
+//
+//	RDGBenchmark.cpp by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGBenchmark.h"
+#include "RDGGeometry.h"
+
+#include <chrono>
+#include <iostream>
+
+using std::cout;
+using std::endl;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+// Fixed seed, so every run carves the same mazes
+static const uint64_t SEED = 1;
+
+
+namespace RDGBenchmark
+{
+	void maze(RDGGenerator::Algorithm algorithm, unsigned int width, unsigned int height,
+		unsigned int runs)
+	{
+		unique_ptr<RDGGenerator> generator = RDGGenerator::create(algorithm);
+		RDGRandom random(SEED);
+		RDGMaze maze;
+		double best = 0;
+		double total = 0;
+
+		const double cells = static_cast<double>(width) * height;
+
+		for (unsigned int i = 0; i < runs; i++)
+		{
+			const Clock::time_point start = Clock::now();
+
+			maze.resize(width, height);
+			generator->carve(maze, random);
+
+			const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+			if (i == 0 || seconds < best)
+				best = seconds;
+
+			total += seconds;
+		}
+
+		cout << RDGGenerator::getName(algorithm) << " " << width << "x" << height
+			<< " (" << runs << " runs)" << endl
+			<< "  best: " << best * 1000.0 << " ms, " << cells / best << " cells/s" << endl
+			<< "  mean: " << (total / runs) * 1000.0 << " ms" << endl
+			<< "  memory: " << maze.getMemoryUsage() / (1024.0 * 1024.0) << " MB" << endl;
+	}
+
+
+	void algorithms(unsigned int width, unsigned int height, unsigned int runs)
+	{
+		const RDGGenerator::Algorithm all[] =
+		{
+			RDGGenerator::Algorithm::BACKTRACKER,
+			RDGGenerator::Algorithm::WILSON,
+			RDGGenerator::Algorithm::ELLER,
+			RDGGenerator::Algorithm::SIDEWINDER,
+			RDGGenerator::Algorithm::GROWING_TREE,
+			RDGGenerator::Algorithm::TILED
+		};
+
+		for (RDGGenerator::Algorithm algorithm : all)
+			maze(algorithm, width, height, runs);
+	}
+
+
+	void geometry(unsigned int width, unsigned int height, unsigned int runs)
+	{
+		RDGRandom random(SEED);
+		RDGMaze maze(width, height);
+		RDGLayout layout;
+		nModelData data;
+		double best = 0;
+
+		RDGGenerator::create(RDGGenerator::Algorithm::BACKTRACKER)->carve(maze, random);
+		layout.build(maze);
+
+		for (unsigned int i = 0; i < runs; i++)
+		{
+			const Clock::time_point start = Clock::now();
+
+			RDGGeometry::build(layout, data);
+
+			const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+			if (i == 0 || seconds < best)
+				best = seconds;
+
+			if (i + 1 < runs)
+			{
+				delete[] data.vertices;
+				delete[] data.uvs;
+				delete[] data.indices;
+			}
+		}
+
+		const double merged = data.indexCount / 3.0;
+		const double tiles = RDGGeometry::countTileFaces(layout) * 2.0;
+
+		cout << "Geometry " << layout.getWidth() << "x" << layout.getHeight() << " tiles" << endl
+			<< "  best: " << best * 1000.0 << " ms" << endl
+			<< "  triangles: " << merged << " (" << tiles << " unmerged, "
+			<< tiles / merged << "x fewer)" << endl;
+
+		delete[] data.vertices;
+		delete[] data.uvs;
+		delete[] data.indices;
+	}
+
+
+	void random(unsigned int count)
+	{
+		RDGRandom random(SEED);
+		unsigned int sum = 0;
+
+		Clock::time_point start = Clock::now();
+
+		for (unsigned int i = 0; i < count; i++)
+			sum += NovaRandom::randomInt(0, 3);
+
+		const double nova = std::chrono::duration<double>(Clock::now() - start).count();
+
+		start = Clock::now();
+
+		for (unsigned int i = 0; i < count; i++)
+			sum += random.nextInt(4);
+
+		const double rdg = std::chrono::duration<double>(Clock::now() - start).count();
+
+		// Print the sum, so the loops cannot be optimised away
+		cout << "Random " << count << " draws (checksum " << sum << ")" << endl
+			<< "  NovaRandom::randomInt: " << count / nova << " draws/s" << endl
+			<< "  RDGRandom::nextInt: " << count / rdg << " draws/s ("
+			<< nova / rdg << "x)" << endl;
+	}
+
+
+	/**
+	 *	Time one batch of queries, and report the rate
+	 */
+	static double timeQueries(const char* name, const RDGNavigation& navigation,
+		vector<RDGPathQuery>& queries, unsigned int threads, bool jump)
+	{
+		const Clock::time_point start = Clock::now();
+
+		navigation.findPaths(queries, threads, jump);
+
+		const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		cout << "  " << name << ": " << queries.size() / seconds << " queries/s" << endl;
+
+		return seconds;
+	}
+
+
+	void navigation(unsigned int width, unsigned int height, unsigned int queries)
+	{
+		RDGRandom random(SEED);
+		RDGMaze maze(width, height);
+		RDGLayout layout;
+
+		RDGGenerator::create(RDGGenerator::Algorithm::TILED)->carve(maze, random);
+		layout.build(maze);
+
+		RDGNavigation navigation(layout);
+		vector<RDGPathQuery> jps(queries);
+		double length = 0;
+
+		// Cells sit on the odd tiles of the layout
+		for (RDGPathQuery& query : jps)
+		{
+			query.start = { random.nextInt(width) * 2 + 1, random.nextInt(height) * 2 + 1 };
+			query.goal = { random.nextInt(width) * 2 + 1, random.nextInt(height) * 2 + 1 };
+		}
+
+		vector<RDGPathQuery> astar = jps;
+		vector<RDGPathQuery> batched = jps;
+		vector<RDGPathQuery> field = jps;
+
+		cout << "Navigation " << layout.getWidth() << "x" << layout.getHeight() << " tiles ("
+			<< queries << " queries)" << endl;
+
+		timeQueries("A*", navigation, astar, 1, false);
+		timeQueries("JPS", navigation, jps, 1, true);
+		timeQueries("JPS, all threads", navigation, batched, 0, true);
+
+		// Every query heads for the same goal, as when many agents chase the player
+		const Clock::time_point start = Clock::now();
+		const RDGDistanceField& target = navigation.addTarget(jps[0].goal);
+		const double build = std::chrono::duration<double>(Clock::now() - start).count();
+
+		for (RDGPathQuery& query : field)
+			query.goal = jps[0].goal;
+
+		timeQueries("Distance field", navigation, field, 1, true);
+
+		cout << "  field build: " << build * 1000.0 << " ms, "
+			<< target.getMemoryUsage() / (1024.0 * 1024.0) << " MB" << endl;
+
+		for (unsigned int i = 0; i < queries; i++)
+		{
+			if (astar[i].length != jps[i].length || batched[i].length != jps[i].length)
+				cout << "  query " << i << " lengths differ!" << endl;
+
+			length += jps[i].length;
+		}
+
+		cout << "  mean length: " << length / queries << " tiles" << endl;
+	}
+
+
+	void layouts(unsigned int width, unsigned int height, unsigned int runs)
+	{
+		const RDGLayoutGenerator::Style all[] =
+		{
+			RDGLayoutGenerator::Style::MAZE,
+			RDGLayoutGenerator::Style::ROOMS,
+			RDGLayoutGenerator::Style::CAVES
+		};
+
+		// Odd sizes, so mazes fill the whole layout
+		width |= 1;
+		height |= 1;
+
+		const double tiles = static_cast<double>(width) * height;
+
+		for (RDGLayoutGenerator::Style style : all)
+		{
+			unique_ptr<RDGLayoutGenerator> generator = RDGLayoutGenerator::create(style);
+			RDGRandom random(SEED);
+			RDGLayout layout;
+			double best = 0;
+
+			for (unsigned int i = 0; i < runs; i++)
+			{
+				const Clock::time_point start = Clock::now();
+
+				generator->generate(layout, width, height, random);
+
+				const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+				if (i == 0 || seconds < best)
+					best = seconds;
+			}
+
+			cout << "Layout " << RDGLayoutGenerator::getName(style) << " " << width << "x" << height
+				<< " tiles (" << runs << " runs)" << endl
+				<< "  best: " << best * 1000.0 << " ms, " << tiles / best << " tiles/s" << endl;
+		}
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+//
+//	RDGBenchmark.h by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGLayoutGenerator.h"
+#include "RDGNavigation.h"
+
+/**
+ *	Headless timings for the dungeon generator.  These run without a window,
+	and print their results to the console.
+ */
+namespace RDGBenchmark
+{
+	/**
+	 *	Time the carving of a maze, reporting cells per second and memory used
+
+	 *	@param algorithm : Algorithm used to carve the maze
+	 *	@param width : Number of cells in the X axis
+	 *	@param height : Number of cells in the Y axis
+	 *	@param runs : Number of mazes to carve
+	 */
+	void maze(RDGGenerator::Algorithm algorithm, unsigned int width, unsigned int height,
+		unsigned int runs);
+
+	/**
+	 *	Time every maze algorithm against the same maze size
+	 */
+	void algorithms(unsigned int width, unsigned int height, unsigned int runs);
+
+	/**
+	 *	Time building the wall geometry for a maze, and compare its triangle count
+		with one quad per tile face
+
+	 *	@param width : Number of cells in the X axis
+	 *	@param height : Number of cells in the Y axis
+	 *	@param runs : Number of times to build the geometry
+	 */
+	void geometry(unsigned int width, unsigned int height, unsigned int runs);
+
+	/**
+	 *	Time RDGRandom against NovaRandom, drawing a direction as the maze
+		generators do
+
+	 *	@param count : Number of numbers to draw from each
+	 */
+	void random(unsigned int count);
+
+	/**
+	 *	Time path queries between random cells of a maze, with A*, jump point
+		search (on one thread, and batched across every thread), and a distance
+		field to a single goal
+
+	 *	@param width : Number of cells in the X axis
+	 *	@param height : Number of cells in the Y axis
+	 *	@param queries : Number of paths to find with each method
+	 */
+	void navigation(unsigned int width, unsigned int height, unsigned int queries);
+
+	/**
+	 *	Time the generation of a layout in each style, reporting tiles per second
+
+	 *	@param width : Number of tiles in the X axis
+	 *	@param height : Number of tiles in the Y axis
+	 *	@param runs : Number of layouts to generate in each style
+	 */
+	void layouts(unsigned int width, unsigned int height, unsigned int runs);
+}
@@ -0,0 +1,66 @@
+//
+//	RDGChunk.cpp by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGChunk.h"
+
+
+static const unsigned int STREAM_MAZE = 0;
+static const unsigned int STREAM_TOP = 1;
+static const unsigned int STREAM_LEFT = 2;
+
+
+/**
+ *	SplitMix64 finaliser - scrambles every bit of the input into the output
+ */
+static inline uint64_t mix(uint64_t z)
+{
+	z += 0x9e3779b97f4a7c15ull;
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+	return z ^ (z >> 31);
+}
+
+
+RDGChunk::RDGChunk(int x, int y)
+{
+	mX = x;
+	mY = y;
+}
+
+
+uint64_t RDGChunk::getSeed(uint64_t seed, int x, int y, unsigned int stream)
+{
+	return mix(mix(mix(seed + stream) + static_cast<uint32_t>(x)) + static_cast<uint32_t>(y));
+}
+
+
+void RDGChunk::generate(uint64_t seed, unsigned int cells, const RDGGenerator& generator)
+{
+	RDGRandom random(getSeed(seed, mX, mY, STREAM_MAZE));
+	RDGMaze maze(cells, cells);
+
+	generator.carve(maze, random);
+
+	// The right and bottom edges come from the neighbouring chunks
+	mLayout.build(maze, false);
+
+	if (cells == 0)
+		return;
+
+	// Open one passage through each of the edges this chunk owns.  The chunk
+	// on the other side never needs to know where, as the wall is ours.
+	const unsigned int top = static_cast<unsigned int>(getSeed(seed, mX, mY, STREAM_TOP) % cells);
+	const unsigned int left = static_cast<unsigned int>(getSeed(seed, mX, mY, STREAM_LEFT) % cells);
+
+	mLayout.setWall(top * 2 + 1, 0, false);
+	mLayout.setWall(0, left * 2 + 1, false);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+//
+//	RDGChunk.h by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGGenerator.h"
+#include "RDGLayout.h"
+
+/**
+ *	A square piece of an endless dungeon.
+
+ *	A chunk's layout depends only on the dungeon's seed and the chunk's position,
+	so any chunk can be generated (or regenerated) on its own, in any order.
+
+ *	Each chunk owns the walls along its top and left edges, and the chunks below
+	and to the right of it supply the walls along its other two edges.  One
+	passage is opened through each of the owned edges, so every chunk is joined
+	to the chunk above it and the chunk to its left, and the whole dungeon is
+	connected.
+ */
+class RDGChunk
+{
+public:
+	RDGChunk(int x, int y);
+
+	/**
+	 *	Generate the chunk's layout
+
+	 *	@param seed : Seed of the whole dungeon
+	 *	@param cells : Width and height of the chunk, in maze cells.  The layout
+			will be twice this size, in tiles.
+	 *	@param generator : Algorithm used to carve the chunk's maze
+	 */
+	void generate(uint64_t seed, unsigned int cells, const RDGGenerator& generator);
+
+	int getX() const { return mX; }
+	int getY() const { return mY; }
+
+	const RDGLayout& getLayout() const { return mLayout; }
+
+	/**
+	 *	Derive a seed from the dungeon's seed and a chunk position
+
+	 *	@param seed : Seed of the whole dungeon
+	 *	@param x : X position of the chunk
+	 *	@param y : Y position of the chunk
+	 *	@param stream : Separates seeds used for different purposes in the same chunk
+
+	 *	@return the derived seed
+	 */
+	static uint64_t getSeed(uint64_t seed, int x, int y, unsigned int stream);
+
+protected:
+	int mX;
+	int mY;
+
+	RDGLayout mLayout;
+};
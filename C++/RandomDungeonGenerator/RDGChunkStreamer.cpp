@@ -0,0 +1,207 @@
+//
+//	RDGChunkStreamer.cpp by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGChunkStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+
+using std::lock_guard;
+using std::mutex;
+using std::unique_lock;
+
+
+RDGChunkStreamer::RDGChunkStreamer(uint64_t seed, unsigned int cells, unsigned int radius,
+	unsigned int capacity, RDGGenerator::Algorithm algorithm, unsigned int threads)
+{
+	const size_t area = (radius * 2 + 1) * (radius * 2 + 1);
+
+	mSeed = seed;
+	mCells = std::max(cells, 1u);
+	mRadius = static_cast<int>(radius);
+	mCapacity = std::max(static_cast<size_t>(capacity), area);
+	mFocusX = 0;
+	mFocusY = 0;
+	mStopping = false;
+
+	mGenerator = RDGGenerator::create(algorithm);
+
+	for (unsigned int i = 0; i < std::max(threads, 1u); i++)
+		mWorkers.push_back(std::thread(&RDGChunkStreamer::work, this));
+}
+
+
+RDGChunkStreamer::~RDGChunkStreamer()
+{
+	{
+		lock_guard<mutex> lock(mMutex);
+		mStopping = true;
+	}
+
+	mWake.notify_all();
+
+	for (std::thread& worker : mWorkers)
+		worker.join();
+}
+
+
+void RDGChunkStreamer::setFocus(float x, float y)
+{
+	const float size = static_cast<float>(getChunkSize());
+	vector<Key> missing;
+
+	mFocusX = static_cast<int>(floorf(x / size));
+	mFocusY = static_cast<int>(floorf(y / size));
+
+	for (int cy = mFocusY - mRadius; cy <= mFocusY + mRadius; cy++)
+	{
+		for (int cx = mFocusX - mRadius; cx <= mFocusX + mRadius; cx++)
+		{
+			const Key key = makeKey(cx, cy);
+			auto loaded = mLoaded.find(key);
+
+			if (loaded != mLoaded.end())
+			{
+				// Mark as most recently used
+				mUsed.splice(mUsed.begin(), mUsed, loaded->second.used);
+			}
+			else if (mRequested.count(key) == 0)
+				missing.push_back(key);
+		}
+	}
+
+	// Generate the chunks nearest the focus first
+	std::sort(missing.begin(), missing.end(), [this](Key a, Key b)
+	{
+		const int ax = keyX(a) - mFocusX;
+		const int ay = keyY(a) - mFocusY;
+		const int bx = keyX(b) - mFocusX;
+		const int by = keyY(b) - mFocusY;
+
+		return ax * ax + ay * ay < bx * bx + by * by;
+	});
+
+	{
+		lock_guard<mutex> lock(mMutex);
+
+		// Forget queued chunks the focus has moved away from
+		for (auto iter = mQueue.begin(); iter != mQueue.end();)
+		{
+			if (inFocus(keyX(*iter), keyY(*iter)))
+				++iter;
+			else
+			{
+				mRequested.erase(*iter);
+				iter = mQueue.erase(iter);
+			}
+		}
+
+		for (Key key : missing)
+		{
+			mQueue.push_back(key);
+			mRequested.insert(key);
+		}
+	}
+
+	if (!missing.empty())
+		mWake.notify_all();
+}
+
+
+void RDGChunkStreamer::poll(vector<shared_ptr<RDGChunk>>& loaded,
+	vector<shared_ptr<RDGChunk>>& evicted)
+{
+	vector<shared_ptr<RDGChunk>> finished;
+
+	{
+		lock_guard<mutex> lock(mMutex);
+		finished.swap(mFinished);
+	}
+
+	for (shared_ptr<RDGChunk>& chunk : finished)
+	{
+		const Key key = makeKey(chunk->getX(), chunk->getY());
+
+		mRequested.erase(key);
+		mUsed.push_front(key);
+		mLoaded[key] = { chunk, mUsed.begin() };
+
+		loaded.push_back(chunk);
+	}
+
+	// Evict the least recently used chunks, never touching the focus area
+	while (mLoaded.size() > mCapacity)
+	{
+		const Key key = mUsed.back();
+
+		if (inFocus(keyX(key), keyY(key)))
+			break;
+
+		auto entry = mLoaded.find(key);
+
+		evicted.push_back(entry->second.chunk);
+
+		mUsed.pop_back();
+		mLoaded.erase(entry);
+	}
+}
+
+
+RDGChunkStreamer::Key RDGChunkStreamer::makeKey(int x, int y)
+{
+	return (static_cast<Key>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+
+int RDGChunkStreamer::keyX(Key key)
+{
+	return static_cast<int>(static_cast<uint32_t>(key >> 32));
+}
+
+
+int RDGChunkStreamer::keyY(Key key)
+{
+	return static_cast<int>(static_cast<uint32_t>(key));
+}
+
+
+bool RDGChunkStreamer::inFocus(int x, int y) const
+{
+	return std::abs(x - mFocusX) <= mRadius && std::abs(y - mFocusY) <= mRadius;
+}
+
+
+void RDGChunkStreamer::work()
+{
+	Key key;
+
+	while (true)
+	{
+		{
+			unique_lock<mutex> lock(mMutex);
+
+			mWake.wait(lock, [this]() { return mStopping || !mQueue.empty(); });
+
+			if (mStopping)
+				return;
+
+			key = mQueue.front();
+			mQueue.pop_front();
+		}
+
+		shared_ptr<RDGChunk> chunk = std::make_shared<RDGChunk>(keyX(key), keyY(key));
+
+		chunk->generate(mSeed, mCells, *mGenerator);
+
+		lock_guard<mutex> lock(mMutex);
+		mFinished.push_back(chunk);
+	}
+}
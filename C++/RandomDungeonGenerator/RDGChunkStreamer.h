@@ -0,0 +1,118 @@
+#pragma once
+
+//
+//	RDGChunkStreamer.h by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "RDGChunk.h"
+
+using std::shared_ptr;
+
+/**
+ *	Keeps the chunks of an endless dungeon loaded around a focus point.
+
+ *	Missing chunks near the focus are generated on background threads, nearest
+	first.  Once more than the capacity are loaded, the least recently used
+	chunks outside the focus area are evicted, so memory use stays the same
+	however far the focus travels.
+
+ *	All functions must be called from the same thread.
+ */
+class RDGChunkStreamer
+{
+public:
+	/**
+	 *	@param seed : Seed of the whole dungeon
+	 *	@param cells : Width and height of each chunk, in maze cells
+	 *	@param radius : Chunks up to this many chunks away from the focus are loaded
+	 *	@param capacity : Most chunks to keep loaded.  Raised to fit the focus area
+			if it is too small.
+	 *	@param algorithm : Algorithm used to carve each chunk
+	 *	@param threads : Number of background threads generating chunks
+	 */
+	RDGChunkStreamer(uint64_t seed, unsigned int cells, unsigned int radius, unsigned int capacity,
+		RDGGenerator::Algorithm algorithm, unsigned int threads = 1);
+
+	~RDGChunkStreamer();
+
+	/**
+	 *	Move the focus, queueing any chunks around it that are not loaded
+
+	 *	@param x : X position of the focus, in layout tiles
+	 *	@param y : Y position of the focus, in layout tiles
+	 */
+	void setFocus(float x, float y);
+
+	/**
+	 *	Collect the chunks finished since the last poll, and evict chunks if there
+		are more than the capacity loaded
+
+	 *	@param loaded : Receives the chunks which have finished generating
+	 *	@param evicted : Receives the chunks which have been unloaded
+	 */
+	void poll(vector<shared_ptr<RDGChunk>>& loaded, vector<shared_ptr<RDGChunk>>& evicted);
+
+	/**
+	 *	@return the width and height of each chunk, in layout tiles
+	 */
+	unsigned int getChunkSize() const { return mCells * 2; }
+
+	/**
+	 *	@return the number of chunks currently loaded
+	 */
+	size_t getLoadedCount() const { return mLoaded.size(); }
+
+protected:
+	typedef uint64_t Key;
+
+	struct _entry
+	{
+		shared_ptr<RDGChunk> chunk;
+		std::list<Key>::iterator used;
+	};
+
+	uint64_t mSeed;
+	unsigned int mCells;
+	int mRadius;
+	size_t mCapacity;
+	int mFocusX;
+	int mFocusY;
+
+	unique_ptr<RDGGenerator> mGenerator;
+
+	// Only touched by the owning thread
+	std::unordered_map<Key, _entry> mLoaded;
+	std::list<Key> mUsed;
+	std::unordered_set<Key> mRequested;
+
+	// Shared with the workers
+	std::mutex mMutex;
+	std::condition_variable mWake;
+	std::deque<Key> mQueue;
+	vector<shared_ptr<RDGChunk>> mFinished;
+	bool mStopping;
+
+	vector<std::thread> mWorkers;
+
+	static Key makeKey(int x, int y);
+	static int keyX(Key key);
+	static int keyY(Key key);
+
+	bool inFocus(int x, int y) const;
+	void work();
+};
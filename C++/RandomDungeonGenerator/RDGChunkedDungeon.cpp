@@ -0,0 +1,122 @@
+//
+//	RDGChunkedDungeon.cpp by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGChunkedDungeon.h"
+
+
+// 16x16 cells (32x32 tiles) per chunk, keeping a 5x5 block loaded around the
+// camera, with room for a ring of recently left chunks behind it
+static const unsigned int CHUNK_CELLS = 16;
+static const unsigned int CHUNK_RADIUS = 2;
+static const unsigned int CHUNK_CAPACITY = 49;
+
+// Speed the camera travels across the dungeon, in tiles per second
+static const float CAMERA_SPEED = 8.0f;
+
+
+RDGChunkedDungeon::RDGChunkedDungeon(uint64_t seed, RDGGenerator::Algorithm algorithm)
+	: mStreamer(seed, CHUNK_CELLS, CHUNK_RADIUS, CHUNK_CAPACITY, algorithm)
+{
+	mFocus = NovaVectorUtil::newInstance(0, 0);
+}
+
+
+void RDGChunkedDungeon::setupStage()
+{
+	// Load the package for the App
+	mPackage.load("PYE_PACKAGE.nova");
+
+	mWallTexture = mPackage.findImage("WALL");
+
+	mFloor.model = nContext->getModelFactory()->newModel();
+	mFloor.model->createFromData(nContext->getRenderer()->getPlane(), mPackage.findImage("FLOOR"));
+	mFloor.model->build();
+	mFloor.colour = NovaColour::WHITE;
+	mFloor.transMask = NovaColour::NONE;
+
+	mStreamer.setFocus(mFocus.x, mFocus.y);
+}
+
+
+void RDGChunkedDungeon::update(long millis)
+{
+	vector<shared_ptr<RDGChunk>> loaded;
+	vector<shared_ptr<RDGChunk>> evicted;
+
+	const float seconds = static_cast<float>(millis) / 1000.0f;
+	const float size = static_cast<float>(mStreamer.getChunkSize());
+
+	// Travel diagonally, forever
+	mFocus.x += CAMERA_SPEED * seconds;
+	mFocus.y += CAMERA_SPEED * seconds * 0.5f;
+
+	nContext->getMainScene()->setViewMatrix(
+		NovaMatrixUtil::view(mFocus.x, 25.0f, mFocus.y, mFocus.x, 0, mFocus.y, 0, 1, 0));
+
+	mStreamer.setFocus(mFocus.x, mFocus.y);
+	mStreamer.poll(loaded, evicted);
+
+	for (const shared_ptr<RDGChunk>& chunk : loaded)
+		makeGeometry(*chunk);
+
+	for (const shared_ptr<RDGChunk>& chunk : evicted)
+	{
+		auto geometry = mGeometry.find(chunk.get());
+
+		if (geometry != mGeometry.end())
+		{
+			geometry->second.model->release();
+			mGeometry.erase(geometry);
+		}
+	}
+
+	// Keep the floor under the loaded area
+	mFloor.transform.setPosition(mFocus.x, -0.5f, mFocus.y)
+		.setRotation(90, 1, 0, 0)
+		.setScale(size * (CHUNK_RADIUS * 2 + 1), size * (CHUNK_RADIUS * 2 + 1), 1);
+}
+
+
+void RDGChunkedDungeon::addToScene()
+{
+	nContext->getMainScene()->add({ &mFloor });
+
+	for (auto& geometry : mGeometry)
+		nContext->getMainScene()->add({ &geometry.second });
+}
+
+
+void RDGChunkedDungeon::release()
+{
+	for (auto& geometry : mGeometry)
+		geometry.second.model->release();
+
+	mGeometry.clear();
+}
+
+
+void RDGChunkedDungeon::makeGeometry(const RDGChunk& chunk)
+{
+	nModelData data;
+	Model& geometry = mGeometry[&chunk];
+
+	const float size = static_cast<float>(mStreamer.getChunkSize());
+
+	RDGGeometry::build(chunk.getLayout(), data);
+
+	geometry.model = nContext->getModelFactory()->newModel();
+	geometry.model->createFromData(data, mWallTexture);
+	geometry.model->build();
+	geometry.model->cleanUp();
+	geometry.colour = NovaColour::WHITE;
+	geometry.transMask = NovaColour::NONE;
+	geometry.transform.setPosition(chunk.getX() * size, 0, chunk.getY() * size);
+}
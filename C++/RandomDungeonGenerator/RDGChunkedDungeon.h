@@ -0,0 +1,51 @@
+#pragma once
+
+//
+//	RDGChunkedDungeon.h by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include <NovaStage.h>
+#include <NovaPackage.h>
+
+#include "RDGChunkStreamer.h"
+#include "RDGGeometry.h"
+
+/**
+ *	Stage showing an endless dungeon, streamed in chunks around a camera which
+	travels across it.  Only the chunks near the camera are kept in memory.
+ */
+class RDGChunkedDungeon : public NovaStage
+{
+public:
+	/**
+	 *	@param seed : Seed of the dungeon.  The same seed always gives the same dungeon.
+	 *	@param algorithm : Algorithm used to carve each chunk
+	 */
+	RDGChunkedDungeon(uint64_t seed,
+		RDGGenerator::Algorithm algorithm = RDGGenerator::Algorithm::BACKTRACKER);
+
+	void update(long millis);
+	void addToScene();
+	void setupStage();
+	void release();
+
+protected:
+	NovaPackage mPackage;
+	nImage mWallTexture;
+	Model mFloor;
+
+	RDGChunkStreamer mStreamer;
+
+	std::unordered_map<const RDGChunk*, Model> mGeometry;
+
+	NovaVector2 mFocus;
+
+	void makeGeometry(const RDGChunk& chunk);
+};
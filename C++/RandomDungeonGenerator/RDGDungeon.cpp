@@ -11,14 +11,21 @@
 
 #include "RDGDungeon.h"
 
+#include <algorithm>
 
-static const unsigned int NODE_RIGHT = 0;
-static const unsigned int NODE_DOWN = 1;
-static const unsigned int NODE_LEFT = 2;
-static const unsigned int NODE_UP = 3;
 
+RDGDungeon::RDGDungeon(unsigned int width, unsigned int height, uint64_t seed,
+	RDGGenerator::Algorithm algorithm)
+	: RDGDungeon(width, height, seed, unique_ptr<RDGLayoutGenerator>(new RDGMazeLayout(algorithm)))
+{
+
+}
 
-RDGDungeon::RDGDungeon(unsigned int width, unsigned int height)
+
+RDGDungeon::RDGDungeon(unsigned int width, unsigned int height, uint64_t seed,
+	unique_ptr<RDGLayoutGenerator> generator)
+	: mWallTexture(nullptr), mTilesX(0), mTilesY(0), mNavigation(mLayout), mRandom(seed),
+	mGenerator(std::move(generator))
 {
 	mDimensions = NovaVectorUtil::newInstance(width, height);
 }
@@ -26,13 +33,49 @@ RDGDungeon::RDGDungeon(unsigned int width, unsigned int height)
 
 void RDGDungeon::addToScene()
 {
-	nContext->getMainScene()->add({ &mFloor, &mGeometry });
+	nContext->getMainScene()->add({ &mFloor });
+
+	for (Model& geometry : mGeometry)
+		nContext->getMainScene()->add({ &geometry });
 }
 
 
 void RDGDungeon::update(long millis)
 {
+	// Rebuild any geometry tiles edited since the last frame
+	for (unsigned int tile = 0; tile < mDirty.size(); tile++)
+	{
+		if (mDirty[tile])
+		{
+			mGeometry[tile].model->release();
+			makeTile(tile);
+		}
+	}
+}
+
 
+bool RDGDungeon::setWall(unsigned int x, unsigned int y, bool wall)
+{
+	if (x >= mLayout.getWidth() || y >= mLayout.getHeight() || mLayout.isWall(x, y) == wall)
+		return false;
+
+	mLayout.setWall(x, y, wall);
+	mNavigation.clearTargets();
+
+	// The neighbouring tiles' faces against this one change too, which may be
+	// in the next geometry tile over
+	const unsigned int left = (x > 0 ? x - 1 : x) / GEOMETRY_TILE;
+	const unsigned int right = std::min(x + 1, mLayout.getWidth() - 1) / GEOMETRY_TILE;
+	const unsigned int top = (y > 0 ? y - 1 : y) / GEOMETRY_TILE;
+	const unsigned int bottom = std::min(y + 1, mLayout.getHeight() - 1) / GEOMETRY_TILE;
+
+	for (unsigned int i = top; i <= bottom; i++)
+	{
+		for (unsigned int j = left; j <= right; j++)
+			mDirty[i * mTilesX + j] = true;
+	}
+
+	return true;
 }
 
 
@@ -48,8 +91,6 @@ void RDGDungeon::setupStage()
 
 void RDGDungeon::generate()
 {
-	_node* pNode;
-
 	// Adjust dimensions to be odd-numbered (allows for surrounding walls)
 	if (static_cast<int>(mDimensions.x) % 2 == 0)
 		mDimensions.x += 1;
@@ -57,296 +98,37 @@ void RDGDungeon::generate()
 	if (static_cast<int>(mDimensions.y) % 2 == 0)
 		mDimensions.y += 1;
 
-	const unsigned int halfWidth = static_cast<const int>(mDimensions.x / 2);
-	const unsigned int halfHeight = static_cast<const int>(mDimensions.y / 2);
-
-	mNodeList = DBG_NEW _node*[halfHeight];
-
-	for (int i = 0; i < halfHeight; i++)
-	{
-		mNodeList[i] = DBG_NEW _node[halfWidth];
-
-		for (int j = 0; j < halfWidth; j++)
-		{
-			pNode = &mNodeList[i][j];
-
-			pNode->position = NovaVectorUtil::newInstance(j, i);
-			pNode->visited = false;
-			pNode->walls.set();
-			pNode->previous = nullptr;
-
-			if (i == 0)
-				pNode->neighbours[NODE_UP] = nullptr;
-			else
-			{
-				if (i == halfHeight - 1)
-					pNode->neighbours[NODE_DOWN] = nullptr;
-
-				pNode->neighbours[NODE_UP] = &mNodeList[i - 1][j];
-				pNode->neighbours[NODE_UP]->neighbours[NODE_DOWN] = pNode;
-			}
-
-			if (j == 0)
-				pNode->neighbours[NODE_LEFT] = nullptr;
-			else
-			{
-				if (j == halfWidth - 1)
-					pNode->neighbours[NODE_RIGHT] = nullptr;
-
-				pNode->neighbours[NODE_LEFT] = &mNodeList[i][j - 1];
-				pNode->neighbours[NODE_LEFT]->neighbours[NODE_RIGHT] = pNode;
-			}
-		}
-	}
-
-	// Node list allocated
 	makePath();
 	makeGeometry();
-
-	for (int i = 0; i < halfHeight; i++)
-		delete[] mNodeList[i];
-
-	delete[] mNodeList;
-	mNodeList = nullptr;
 }
 
 
 void RDGDungeon::makePath()
 {
-	_node* pNode = &mNodeList[0][0];
-	bool complete = false;
-	bitset<4> tested("0000");
-	bool found = false;
-	unsigned int direction;
-
-	// Always want this to run at least once, hence the do-while
-	do
-	{
-		pNode->visited = true;
-
-		// Check that this node has an unvisited neighbour - if not, go backwards
-		while (pNode != nullptr && !hasPath(pNode))
-			pNode = pNode->previous;
-
-		if (pNode == nullptr)
-			return;
-
-		tested.reset();
-
-		found = false;
-
-		do
-		{
-			direction = NovaRandom::randomInt(0, 3);
-
-			if (!tested.test(direction))
-				found = hasPath(pNode, direction);
-
-			tested.set(direction);
-
-		} while (!found && !tested.all());
-
-		if (found)
-			pNode = nextNode(pNode, direction);
-
-		if (pNode == nullptr)
-			complete = true;
-
-	} while (!complete);
-
-	// Layout generation complete
+	mGenerator->generate(mLayout, static_cast<unsigned int>(mDimensions.x),
+		static_cast<unsigned int>(mDimensions.y), mRandom);
 }
 
 
 void RDGDungeon::makeGeometry()
 {
-	// Start with a simplified layout
-	bool** layout = nullptr;
-	vector<NovaVector3> vertex;
-	vector<NovaVector2> uv;
-	vector<unsigned int> index;
-	nModelData data;
-	nImage mGTexture;
 	nImage mFTexture;
 
-	const int width = static_cast<const int>(mDimensions.x);
-	const int height = static_cast<const int>(mDimensions.y);
+	// Any distance fields were built for the old layout
+	mNavigation.clearTargets();
 
-	layout = DBG_NEW bool*[height];
-
-	for (int i = 0; i < height; i++)
-	{
-		layout[i] = DBG_NEW bool[width];
-
-		for (int j = 0; j < width; j++)
-		{
-			if (i == 0 || j == 0)
-				layout[i][j] = true;
-			else if ((i - 1) % 2 == 1)
-			{
-				if ((j - 1) % 2 == 1)
-					layout[i][j] = true;
-				else
-					layout[i][j] = mNodeList[(i - 1) / 2][(j - 1) / 2].walls.test(NODE_DOWN);
-			}
-			else
-			{
-				if ((j - 1) % 2 == 1)
-					layout[i][j] = mNodeList[(i - 1) / 2][(j - 1) / 2].walls.test(NODE_RIGHT);
-				else
-					layout[i][j] = false;
-			}
-		}
-	}
-
-	// Simple layout complete - convert to geometry
-
-	unsigned int element = 0;
-
-	for (int i = 0; i < height; i++)
-	{
-		for (int j = 0; j < width; j++)
-		{
-			if (layout[i][j])
-			{
-				// apply the top plane
-				vertex.push_back(NovaVectorUtil::newInstance(
-					j - 0.5f, 0.5f, i + 0.5f));
-
-				vertex.push_back(NovaVectorUtil::newInstance(
-					j + 0.5f, 0.5f, i + 0.5f));
-
-				vertex.push_back(NovaVectorUtil::newInstance(
-					j - 0.5f, 0.5f, i - 0.5f));
-
-				vertex.push_back(NovaVectorUtil::newInstance(
-					j + 0.5f, 0.5f, i - 0.5f));
-
-				uv.push_back(NovaVectorUtil::newInstance(0.0f, 0.0f));
-				uv.push_back(NovaVectorUtil::newInstance(1.0f, 0.0f));
-				uv.push_back(NovaVectorUtil::newInstance(0.0f, 1.0f));
-				uv.push_back(NovaVectorUtil::newInstance(1.0f, 1.0f));
-
-				index.push_back(element);
-				index.push_back(element + 3);
-				index.push_back(element + 2);
-				index.push_back(element);
-				index.push_back(element + 1);
-				index.push_back(element + 3);
-
-				element += 4;
-
-				// check the left hand side
-				if (j == 0 || !layout[i][j - 1])
-				{
-					vertex.push_back(NovaVectorUtil::newInstance(
-						j - 0.5f, -0.5f, i - 0.5f));
-
-					vertex.push_back(NovaVectorUtil::newInstance(
-						j - 0.5f, -0.5f, i + 0.5f));
-
-					vertex.push_back(NovaVectorUtil::newInstance(
-						j - 0.5f, 0.5f, i - 0.5f));
-
-					vertex.push_back(NovaVectorUtil::newInstance(
-						j - 0.5f, 0.5f, i + 0.5f));
-
-					uv.push_back(NovaVectorUtil::newInstance(0.0f, 0.0f));
-					uv.push_back(NovaVectorUtil::newInstance(1.0f, 0.0f));
-					uv.push_back(NovaVectorUtil::newInstance(0.0f, 1.0f));
-					uv.push_back(NovaVectorUtil::newInstance(1.0f, 1.0f));
-
-					index.push_back(element);
-					index.push_back(element + 3);
-					index.push_back(element + 2);
-					index.push_back(element);
-					index.push_back(element + 1);
-					index.push_back(element + 3);
-
-					element += 4;
-				}
-
-				// check the right hand side
-				if (j == width - 1 || !layout[i][j + 1])
-				{
-					vertex.push_back(NovaVectorUtil::newInstance(j + 0.5f, -0.5f, i + 0.5f));
-					vertex.push_back(NovaVectorUtil::newInstance(j + 0.5f, -0.5f, i - 0.5f));
-					vertex.push_back(NovaVectorUtil::newInstance(j + 0.5f, 0.5f, i + 0.5f));
-					vertex.push_back(NovaVectorUtil::newInstance(j + 0.5f, 0.5f, i - 0.5f));
-
-					uv.push_back(NovaVectorUtil::newInstance(0.0f, 0.0f));
-					uv.push_back(NovaVectorUtil::newInstance(1.0f, 0.0f));
-					uv.push_back(NovaVectorUtil::newInstance(0.0f, 1.0f));
-					uv.push_back(NovaVectorUtil::newInstance(1.0f, 1.0f));
-
-					index.push_back(element);
-					index.push_back(element + 3);
-					index.push_back(element + 2);
-					index.push_back(element);
-					index.push_back(element + 1);
-					index.push_back(element + 3);
-
-					element += 4;
-				}
-
-				// check the front
-				if (i == height - 1 || !layout[i + 1][j])
-				{
-					vertex.push_back(NovaVectorUtil::newInstance(j - 0.5f, -0.5f, i + 0.5f));
-					vertex.push_back(NovaVectorUtil::newInstance(j + 0.5f, -0.5f, i + 0.5f));
-					vertex.push_back(NovaVectorUtil::newInstance(j - 0.5f, 0.5f, i + 0.5f));
-					vertex.push_back(NovaVectorUtil::newInstance(j + 0.5f, 0.5f, i + 0.5f));
-
-					uv.push_back(NovaVectorUtil::newInstance(0.0f, 0.0f));
-					uv.push_back(NovaVectorUtil::newInstance(1.0f, 0.0f));
-					uv.push_back(NovaVectorUtil::newInstance(0.0f, 1.0f));
-					uv.push_back(NovaVectorUtil::newInstance(1.0f, 1.0f));
-
-					index.push_back(element);
-					index.push_back(element + 3);
-					index.push_back(element + 2);
-					index.push_back(element);
-					index.push_back(element + 1);
-					index.push_back(element + 3);
-
-					element += 4;
-				}
-			}
-		}
-	}
-
-	data.vertices = DBG_NEW float[vertex.size() * 3];
-	data.uvs = DBG_NEW float[uv.size() * 2];
-	data.indices = DBG_NEW unsigned int[index.size()];
-
-	data.elementCount = static_cast<unsigned int>(vertex.size());
-	data.indexCount = static_cast<unsigned int>(index.size());
-
-	for (unsigned int i = 0; i < data.elementCount; i++)
-	{
-		memcpy_s(&data.vertices[i * 3], 3 * sizeof(float), vertex.at(i).xyz.data(),
-			3 * sizeof(float));
-
-		memcpy_s(&data.uvs[i * 2], 2 * sizeof(float), uv.at(i).xy.data(), 2 * sizeof(float));
-	}
-
-	memcpy_s(data.indices, data.indexCount * sizeof(unsigned int), index.data(),
-		data.indexCount * sizeof(unsigned int));
+	mWallTexture = mPackage.findImage("WALL");
+	mFTexture = mPackage.findImage("FLOOR");
 
-	vertex.clear();
-	uv.clear();
-	index.clear();
+	mTilesX = (mLayout.getWidth() + GEOMETRY_TILE - 1) / GEOMETRY_TILE;
+	mTilesY = (mLayout.getHeight() + GEOMETRY_TILE - 1) / GEOMETRY_TILE;
 
-	mGTexture = mPackage.findImage("WALL");
-	mFTexture = mPackage.findImage("FLOOR");
+	// Sized once, as the scene holds pointers to each tile's Model
+	mGeometry.resize(mTilesX * mTilesY);
+	mDirty.assign(mTilesX * mTilesY, false);
 
-	mGeometry.model = nContext->getModelFactory()->newModel();
-	mGeometry.model->createFromData(data, mGTexture);
-	mGeometry.model->build();
-	mGeometry.model->cleanUp();
-	mGeometry.colour = NovaColour::WHITE;
-	mGeometry.transMask = NovaColour::NONE;
-	mGeometry.transform.setPosition(static_cast<float>(-width / 2), 0, static_cast<float>(-height / 2));
+	for (unsigned int tile = 0; tile < mGeometry.size(); tile++)
+		makeTile(tile);
 
 	mFloor.model = nContext->getModelFactory()->newModel();
 	mFloor.model->createFromData(nContext->getRenderer()->getPlane(), mFTexture);
@@ -356,64 +138,34 @@ void RDGDungeon::makeGeometry()
 	mFloor.transform.setPosition(0, -0.5f, 0)
 		.setRotation(90, 1, 0, 0)
 		.setScale(mDimensions.x, mDimensions.y, 1);
-
-
-	// delete the layout
-	for (int i = 0; i < height; i++)
-		delete[] layout[i];
-
-	delete[] layout;
-	layout = nullptr;
-}
-
-
-bool RDGDungeon::hasPath(_node* pNode)
-{
-	if (pNode == nullptr)
-		return false;
-
-	for (int i = 0; i < 4; i++)
-	{
-		if (pNode->neighbours[i] != nullptr && !pNode->neighbours[i]->visited)
-			return true;
-	}
-
-	return false;
 }
 
 
-bool RDGDungeon::hasPath(_node* pNode, unsigned int direction)
+void RDGDungeon::makeTile(unsigned int tile)
 {
-	if (pNode == nullptr)
-		return false;
-
-	if (direction > 3)
-		return false;
-
-	return pNode->neighbours[direction] != nullptr && !pNode->neighbours[direction]->visited;
-}
+	nModelData data;
 
+	const int width = static_cast<const int>(mLayout.getWidth());
+	const int height = static_cast<const int>(mLayout.getHeight());
 
-RDGDungeon::_node* RDGDungeon::nextNode(_node* pNode, unsigned int direction)
-{
-	_node* ret = nullptr;
+	const unsigned int x = (tile % mTilesX) * GEOMETRY_TILE;
+	const unsigned int y = (tile / mTilesX) * GEOMETRY_TILE;
 
-	if (pNode == nullptr || direction > 3)
-		return nullptr;
+	const RDGRegion region = { x, y, std::min(GEOMETRY_TILE, mLayout.getWidth() - x),
+		std::min(GEOMETRY_TILE, mLayout.getHeight() - y) };
 
-	ret = pNode->neighbours[direction];
+	Model& geometry = mGeometry[tile];
 
-	if (ret != nullptr)
-	{
-		pNode->walls.set(direction, false);
-		ret->previous = pNode;
+	RDGGeometry::build(mLayout, region, data);
 
-		if (direction < 2)
-			ret->walls.set(direction + 2, false);
-		else
-			ret->walls.set(direction - 2, false);
-	}
+	// Vertices are in layout space, so every tile shares the same transform
+	geometry.model = nContext->getModelFactory()->newModel();
+	geometry.model->createFromData(data, mWallTexture);
+	geometry.model->build();
+	geometry.model->cleanUp();
+	geometry.colour = NovaColour::WHITE;
+	geometry.transMask = NovaColour::NONE;
+	geometry.transform.setPosition(static_cast<float>(-width / 2), 0, static_cast<float>(-height / 2));
 
-	return ret;
+	mDirty[tile] = false;
 }
-
@@ -14,46 +14,85 @@
 #include <NovaStage.h>
 #include <NovaPackage.h>
 
-#include <bitset>
-
-using std::bitset;
+#include "RDGGeometry.h"
+#include "RDGLayoutGenerator.h"
+#include "RDGNavigation.h"
 
 /**
  *	Class to handle the RandomDungeonGenerator's Stage, creating and holding
-	the dungeon geometry, and displaying it
+	the dungeon geometry, and displaying it.
+
+ *	The wall geometry is split into square tiles of GEOMETRY_TILE by
+	GEOMETRY_TILE layout tiles, each its own model.  Editing a wall marks the
+	tiles it touches, and only those are rebuilt on the next update.
  */
 class RDGDungeon : public NovaStage
 {
 public:
-	RDGDungeon(unsigned int width, unsigned int height);
+	/**
+	 *	Width and height of each geometry tile, in layout tiles
+	 */
+	static const unsigned int GEOMETRY_TILE = 32;
+
+	/**
+	 *	@param width : Width of the dungeon, including its outer walls
+	 *	@param height : Height of the dungeon, including its outer walls
+	 *	@param seed : Seed of the dungeon.  The same seed always gives the same dungeon.
+	 *	@param algorithm : Algorithm used to carve the layout
+	 */
+	RDGDungeon(unsigned int width, unsigned int height, uint64_t seed,
+		RDGGenerator::Algorithm algorithm = RDGGenerator::Algorithm::BACKTRACKER);
+
+	/**
+	 *	@param width : Width of the dungeon, including its outer walls
+	 *	@param height : Height of the dungeon, including its outer walls
+	 *	@param seed : Seed of the dungeon.  The same seed always gives the same dungeon.
+	 *	@param generator : Generator used to create the layout
+	 */
+	RDGDungeon(unsigned int width, unsigned int height, uint64_t seed,
+		unique_ptr<RDGLayoutGenerator> generator);
 
 	void update(long millis);
 	void addToScene();
 	void setupStage();
 	void release() {};
 
-protected:
-	struct _node
-	{
-		NovaVector2 position; // Position in array for debug purposes
-		_node* neighbours[4];
-		_node* previous;
-		bitset<4> walls;
-		bool visited;
-	};
+	/**
+	 *	@return path finding over the dungeon's layout
+	 */
+	RDGNavigation& getNavigation() { return mNavigation; }
 
+	/**
+	 *	Change one tile of the layout, such as a wall being knocked down.  The
+		geometry around it is rebuilt on the next update.  Distance fields are
+		removed, as they were built for the old layout.
+
+	 *	@param x : Column of the tile
+	 *	@param y : Row of the tile
+	 *	@param wall : true to make the tile a wall, false for a floor
+
+	 *	@return true if the tile changed
+	 */
+	bool setWall(unsigned int x, unsigned int y, bool wall);
+
+protected:
 	NovaPackage mPackage;
 	NovaVector2 mDimensions;
-	Model mGeometry;
+	nImage mWallTexture;
+	vector<Model> mGeometry;
+	vector<bool> mDirty;
+	unsigned int mTilesX;
+	unsigned int mTilesY;
 	Model mFloor;
 
-	_node** mNodeList;
+	RDGLayout mLayout;
+	RDGNavigation mNavigation;
+	RDGRandom mRandom;
+	unique_ptr<RDGLayoutGenerator> mGenerator;
 
 	void generate();
 	void makePath();
 	void makeGeometry();
-	bool hasPath(_node* pNode);
-	bool hasPath(_node* pNode, unsigned int direction);
-	_node* nextNode(_node* pNode, unsigned int direction);
+	void makeTile(unsigned int tile);
 };
 
@@ -0,0 +1,169 @@
+//
+//	RDGExport.cpp by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGExport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+using std::atomic;
+using std::ofstream;
+using std::thread;
+
+static const unsigned int MAP_NAME_LENGTH = 21;
+
+/**
+ *	Header of a Map Package.  Matches MAPPACKAGE in the LevelViewer, which is
+	built for Windows, where an unsigned long is 32 bits.
+ */
+struct _mappackage
+{
+	char packagename[MAP_NAME_LENGTH + 1];
+	uint32_t numcolumns;
+	uint32_t numrows;
+};
+
+static_assert(sizeof(_mappackage) == 32, "Map Package header must match the LevelViewer's");
+
+
+namespace RDGExport
+{
+	bool writeMapPackage(const RDGLayout& layout, const string& name, const string& filename,
+		bool compressed)
+	{
+		const unsigned int width = layout.getWidth();
+		const unsigned int height = layout.getHeight();
+
+		ofstream stream(filename, std::ios::binary);
+
+		if (!stream.is_open())
+			return false;
+
+		_mappackage package;
+
+		memset(&package, 0, sizeof(_mappackage));
+		memcpy(package.packagename, name.c_str(), std::min<size_t>(name.size(), MAP_NAME_LENGTH));
+
+		package.numcolumns = width;
+		package.numrows = height;
+
+		stream.write(reinterpret_cast<const char*>(&package), sizeof(_mappackage));
+
+		// Worst case for the compressed rows is a pair for every tile
+		vector<char> row(compressed ? width * 2 : width);
+
+		for (unsigned int y = 0; y < height; y++)
+		{
+			const bool edgeRow = y == 0 || y + 1 == height;
+			size_t length = 0;
+
+			for (unsigned int x = 0; x < width; )
+			{
+				unsigned int end;
+				char tile;
+
+				// Runs of floor, and runs of wall up to the next floor, a word at a time
+				if (layout.isWall(x, y))
+				{
+					tile = (edgeRow || x == 0 || x + 1 == width) ? 'W' : 'w';
+					end = edgeRow ? width : std::min(layout.findNext(x, y, false), width - 1);
+
+					// The outer walls either side of the row are runs of their own
+					if (x == 0 || end == x)
+						end = x + 1;
+				}
+				else
+				{
+					tile = 'F';
+					end = layout.findNext(x, y, true);
+				}
+
+				if (compressed)
+				{
+					for (unsigned int count = end - x; count > 0; )
+					{
+						const unsigned int run = std::min(count, 255u);
+
+						row[length++] = static_cast<char>(run);
+						row[length++] = tile;
+						count -= run;
+					}
+				}
+				else
+				{
+					memset(&row[length], tile, end - x);
+					length += end - x;
+				}
+
+				x = end;
+			}
+
+			stream.write(row.data(), length);
+		}
+
+		return stream.good();
+	}
+
+
+	unsigned int batch(unsigned int count, unsigned int width, unsigned int height, uint64_t seed,
+		const string& directory, RDGLayoutGenerator::Style style, bool compressed, unsigned int threads)
+	{
+		RDGRandom random(seed);
+		vector<RDGRandom> streams;
+		vector<thread> workers;
+		atomic<unsigned int> nextDungeon(0);
+		atomic<unsigned int> written(0);
+
+		if (threads == 0)
+			threads = std::max(thread::hardware_concurrency(), 1u);
+
+		threads = std::max(std::min(threads, count), 1u);
+
+		// Streams are split off before any work starts, so each dungeon is the
+		// same however many threads there are
+		streams.reserve(count);
+
+		for (unsigned int i = 0; i < count; i++)
+			streams.push_back(random.split());
+
+		auto worker = [&]()
+		{
+			unique_ptr<RDGLayoutGenerator> generator = RDGLayoutGenerator::create(style);
+			RDGLayout layout;
+			unsigned int i;
+
+			while ((i = nextDungeon++) < count)
+			{
+				const string number = std::to_string(i);
+				const string filename = directory + "/dungeon_" + string(5 - std::min<size_t>(number.size(), 5), '0')
+					+ number + (compressed ? ".bomz" : ".bom");
+
+				generator->generate(layout, width, height, streams[i]);
+
+				if (writeMapPackage(layout, "RDG_" + number, filename, compressed))
+					written++;
+			}
+		};
+
+		for (unsigned int i = 1; i < threads; i++)
+			workers.push_back(thread(worker));
+
+		worker();
+
+		for (thread& t : workers)
+			t.join();
+
+		return written;
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+//
+//	RDGExport.h by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include <string>
+
+#include "RDGLayoutGenerator.h"
+
+using std::string;
+
+/**
+ *	Writes dungeon layouts as LevelViewer Map Packages (.bom).
+
+ *	A package is the MAPPACKAGE header (name, columns, rows) followed by one
+	character per tile, row by row: 'W' for the outer wall, 'w' for the walls
+	inside it, and 'F' for floors.  The compressed variant (.bomz) stores each
+	row as pairs of a count (1 to 255) and a character instead.
+ */
+namespace RDGExport
+{
+	/**
+	 *	Write a layout to a Map Package file
+
+	 *	@param layout : Layout to write
+	 *	@param name : Name of the map, stored in the package.  Cut down to 21 characters.
+	 *	@param filename : Path and name of the file to write
+	 *	@param compressed : Run-length encode the rows (use the .bomz extension)
+
+	 *	@return true if the file was written
+	 */
+	bool writeMapPackage(const RDGLayout& layout, const string& name, const string& filename,
+		bool compressed = false);
+
+	/**
+	 *	Generate a batch of dungeons on a pool of worker threads, and write each
+		to its own Map Package.  Dungeon i is named RDG_<i>, and is written to
+		<directory>/dungeon_<i>.bom (or .bomz).
+
+	 *	Each dungeon gets its own random stream, split in order from the seed,
+		so the batch is the same however many threads there are.
+
+	 *	@param count : Number of dungeons to generate
+	 *	@param width : Width of each dungeon in tiles, including its outer walls
+	 *	@param height : Height of each dungeon in tiles, including its outer walls
+	 *	@param seed : Seed of the batch
+	 *	@param directory : Existing directory to write the packages into
+	 *	@param style : Style of layout to generate
+	 *	@param compressed : Write the compressed variant
+	 *	@param threads : Number of worker threads.  0 uses one per hardware thread.
+
+	 *	@return the number of packages written
+	 */
+	unsigned int batch(unsigned int count, unsigned int width, unsigned int height, uint64_t seed,
+		const string& directory, RDGLayoutGenerator::Style style, bool compressed = false,
+		unsigned int threads = 0);
+}
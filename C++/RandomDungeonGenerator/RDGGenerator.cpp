@@ -0,0 +1,607 @@
+//
+//	RDGGenerator.cpp by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGGenerator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using std::atomic;
+using std::thread;
+
+
+/**
+ *	Open the passage leading out of a cell, given its index in the maze
+ */
+static inline void openCell(uint8_t* cells, size_t stride, size_t index, unsigned int direction)
+{
+	switch (direction)
+	{
+	case NODE_RIGHT:
+		cells[index] |= RDGMaze::CELL_RIGHT;
+		break;
+	case NODE_DOWN:
+		cells[index] |= RDGMaze::CELL_DOWN;
+		break;
+	case NODE_LEFT:
+		cells[index - 1] |= RDGMaze::CELL_RIGHT;
+		break;
+	case NODE_UP:
+		cells[index - stride] |= RDGMaze::CELL_DOWN;
+		break;
+	}
+}
+
+
+/**
+ *	Move a position (relative to its region) and index one cell in a direction
+ */
+static inline void step(unsigned int& x, unsigned int& y, size_t& index, size_t stride,
+	unsigned int direction)
+{
+	switch (direction)
+	{
+	case NODE_RIGHT:
+		x++;
+		index++;
+		break;
+	case NODE_DOWN:
+		y++;
+		index += stride;
+		break;
+	case NODE_LEFT:
+		x--;
+		index--;
+		break;
+	case NODE_UP:
+		y--;
+		index -= stride;
+		break;
+	}
+}
+
+
+void RDGGenerator::carve(RDGMaze& maze, RDGRandom& random) const
+{
+	const RDGRegion region = { 0, 0, maze.getWidth(), maze.getHeight() };
+
+	carve(maze, region, random);
+}
+
+
+unique_ptr<RDGGenerator> RDGGenerator::create(Algorithm algorithm)
+{
+	switch (algorithm)
+	{
+	case Algorithm::WILSON:
+		return unique_ptr<RDGGenerator>(new RDGWilson());
+	case Algorithm::ELLER:
+		return unique_ptr<RDGGenerator>(new RDGEller());
+	case Algorithm::SIDEWINDER:
+		return unique_ptr<RDGGenerator>(new RDGSidewinder());
+	case Algorithm::GROWING_TREE:
+		return unique_ptr<RDGGenerator>(new RDGGrowingTree());
+	case Algorithm::TILED:
+		return unique_ptr<RDGGenerator>(new RDGTiledGenerator(
+			unique_ptr<RDGGenerator>(new RDGBacktracker())));
+	default:
+		return unique_ptr<RDGGenerator>(new RDGBacktracker());
+	}
+}
+
+
+const char* RDGGenerator::getName(Algorithm algorithm)
+{
+	switch (algorithm)
+	{
+	case Algorithm::BACKTRACKER:
+		return "Backtracker";
+	case Algorithm::WILSON:
+		return "Wilson";
+	case Algorithm::ELLER:
+		return "Eller";
+	case Algorithm::SIDEWINDER:
+		return "Sidewinder";
+	case Algorithm::GROWING_TREE:
+		return "Growing Tree";
+	case Algorithm::TILED:
+		return "Tiled Backtracker";
+	}
+
+	return "Unknown";
+}
+
+
+void RDGBacktracker::carve(RDGMaze& maze, const RDGRegion& region, RDGRandom& random) const
+{
+	if (region.width == 0 || region.height == 0)
+		return;
+
+	uint8_t* cells = maze.getCells();
+	const size_t stride = maze.getWidth();
+	const size_t start = region.y * stride + region.x;
+
+	unsigned int directions[4];
+	unsigned int count;
+	unsigned int direction;
+	unsigned int x = 0;
+	unsigned int y = 0;
+	size_t index = start;
+
+	cells[index] |= RDGMaze::CELL_VISITED;
+
+	// The start cell has no parent, so reaching it with nowhere left to go
+	// means every cell has been visited
+	while (true)
+	{
+		count = 0;
+
+		if (x + 1 < region.width && !(cells[index + 1] & RDGMaze::CELL_VISITED))
+			directions[count++] = NODE_RIGHT;
+
+		if (y + 1 < region.height && !(cells[index + stride] & RDGMaze::CELL_VISITED))
+			directions[count++] = NODE_DOWN;
+
+		if (x > 0 && !(cells[index - 1] & RDGMaze::CELL_VISITED))
+			directions[count++] = NODE_LEFT;
+
+		if (y > 0 && !(cells[index - stride] & RDGMaze::CELL_VISITED))
+			directions[count++] = NODE_UP;
+
+		if (count == 0)
+		{
+			// Dead end - step back towards the parent
+			if (index == start)
+				break;
+
+			direction = (cells[index] & RDGMaze::CELL_DIRECTION) >> RDGMaze::CELL_DIRECTION_SHIFT;
+		}
+		else
+		{
+			direction = directions[count == 1 ? 0 : random.nextInt(count)];
+
+			openCell(cells, stride, index, direction);
+		}
+
+		step(x, y, index, stride, direction);
+
+		if (count != 0)
+		{
+			// Record the way back, so we can return here once this branch is done
+			cells[index] |= RDGMaze::CELL_VISITED |
+				(((direction + 2) % 4) << RDGMaze::CELL_DIRECTION_SHIFT);
+		}
+	}
+}
+
+
+void RDGWilson::carve(RDGMaze& maze, const RDGRegion& region, RDGRandom& random) const
+{
+	if (region.width == 0 || region.height == 0)
+		return;
+
+	uint8_t* cells = maze.getCells();
+	const size_t stride = maze.getWidth();
+
+	unsigned int directions[4];
+	unsigned int count;
+	unsigned int direction;
+	unsigned int x;
+	unsigned int y;
+	size_t index;
+
+	// Seed the maze with a single random cell
+	x = random.nextInt(region.width);
+	y = random.nextInt(region.height);
+	cells[(region.y + y) * stride + region.x + x] |= RDGMaze::CELL_VISITED;
+
+	for (unsigned int startY = 0; startY < region.height; startY++)
+	{
+		for (unsigned int startX = 0; startX < region.width; startX++)
+		{
+			const size_t start = (region.y + startY) * stride + region.x + startX;
+
+			if (cells[start] & RDGMaze::CELL_VISITED)
+				continue;
+
+			// Walk until we hit the maze.  Each cell remembers the direction
+			// it was last left by, so revisiting a cell erases the loop.
+			x = startX;
+			y = startY;
+			index = start;
+
+			while (!(cells[index] & RDGMaze::CELL_VISITED))
+			{
+				count = 0;
+
+				if (x + 1 < region.width)
+					directions[count++] = NODE_RIGHT;
+
+				if (y + 1 < region.height)
+					directions[count++] = NODE_DOWN;
+
+				if (x > 0)
+					directions[count++] = NODE_LEFT;
+
+				if (y > 0)
+					directions[count++] = NODE_UP;
+
+				direction = directions[random.nextInt(count)];
+
+				cells[index] = static_cast<uint8_t>((cells[index] & ~RDGMaze::CELL_DIRECTION) |
+					(direction << RDGMaze::CELL_DIRECTION_SHIFT));
+
+				step(x, y, index, stride, direction);
+			}
+
+			// Follow the loop-erased walk, adding it to the maze
+			x = startX;
+			y = startY;
+			index = start;
+
+			while (!(cells[index] & RDGMaze::CELL_VISITED))
+			{
+				direction = (cells[index] & RDGMaze::CELL_DIRECTION) >> RDGMaze::CELL_DIRECTION_SHIFT;
+
+				cells[index] |= RDGMaze::CELL_VISITED;
+				openCell(cells, stride, index, direction);
+
+				step(x, y, index, stride, direction);
+			}
+		}
+	}
+}
+
+
+void RDGSidewinder::carve(RDGMaze& maze, const RDGRegion& region, RDGRandom& random) const
+{
+	uint8_t* cells = maze.getCells();
+	const size_t stride = maze.getWidth();
+
+	for (unsigned int y = 0; y < region.height; y++)
+	{
+		const size_t row = (region.y + y) * stride + region.x;
+		unsigned int runStart = 0;
+
+		for (unsigned int x = 0; x < region.width; x++)
+		{
+			// The first row has nowhere to go up to, so it is one long corridor
+			if (y == 0)
+			{
+				if (x + 1 < region.width)
+					cells[row + x] |= RDGMaze::CELL_RIGHT;
+
+				continue;
+			}
+
+			if (x + 1 == region.width || random.nextBool())
+			{
+				// Close off the run, and join it to the row above
+				const unsigned int exit = runStart + random.nextInt(x - runStart + 1);
+
+				cells[row - stride + exit] |= RDGMaze::CELL_DOWN;
+
+				runStart = x + 1;
+			}
+			else
+				cells[row + x] |= RDGMaze::CELL_RIGHT;
+		}
+	}
+}
+
+
+void RDGGrowingTree::carve(RDGMaze& maze, const RDGRegion& region, RDGRandom& random) const
+{
+	if (region.width == 0 || region.height == 0)
+		return;
+
+	uint8_t* cells = maze.getCells();
+	const size_t stride = maze.getWidth();
+	const unsigned int newest = static_cast<unsigned int>(mNewest * 65536.0f);
+
+	vector<uint32_t> active;
+	unsigned int directions[4];
+	unsigned int count;
+	unsigned int direction;
+	unsigned int pick;
+	unsigned int x;
+	unsigned int y;
+	size_t index;
+
+	x = random.nextInt(region.width);
+	y = random.nextInt(region.height);
+
+	cells[(region.y + y) * stride + region.x + x] |= RDGMaze::CELL_VISITED;
+	active.push_back(y * region.width + x);
+
+	while (!active.empty())
+	{
+		if (random.nextInt(65536) < newest)
+			pick = static_cast<unsigned int>(active.size() - 1);
+		else
+			pick = random.nextInt(static_cast<unsigned int>(active.size()));
+
+		x = active[pick] % region.width;
+		y = active[pick] / region.width;
+		index = (region.y + y) * stride + region.x + x;
+
+		count = 0;
+
+		if (x + 1 < region.width && !(cells[index + 1] & RDGMaze::CELL_VISITED))
+			directions[count++] = NODE_RIGHT;
+
+		if (y + 1 < region.height && !(cells[index + stride] & RDGMaze::CELL_VISITED))
+			directions[count++] = NODE_DOWN;
+
+		if (x > 0 && !(cells[index - 1] & RDGMaze::CELL_VISITED))
+			directions[count++] = NODE_LEFT;
+
+		if (y > 0 && !(cells[index - stride] & RDGMaze::CELL_VISITED))
+			directions[count++] = NODE_UP;
+
+		if (count == 0)
+		{
+			// Nowhere left to grow from this cell - swap it out of the list
+			active[pick] = active.back();
+			active.pop_back();
+			continue;
+		}
+
+		direction = directions[count == 1 ? 0 : random.nextInt(count)];
+
+		openCell(cells, stride, index, direction);
+		step(x, y, index, stride, direction);
+
+		cells[index] |= RDGMaze::CELL_VISITED;
+		active.push_back(y * region.width + x);
+	}
+}
+
+
+const unsigned int RDGEllerRows::NO_SET;
+
+
+RDGEllerRows::RDGEllerRows(unsigned int width)
+{
+	mWidth = width;
+
+	mSets.resize(width);
+	mParents.resize(width);
+	mRemap.resize(width);
+	mLast.resize(width);
+	mHasDown.resize(width);
+
+	reset();
+}
+
+
+void RDGEllerRows::reset()
+{
+	std::fill(mSets.begin(), mSets.end(), NO_SET);
+}
+
+
+void RDGEllerRows::next(uint8_t* row, RDGRandom& random)
+{
+	unsigned int set;
+
+	beginRow();
+	joinRow(row, random, false);
+
+	// Every set must carry on to the next row through at least one cell
+	for (unsigned int x = 0; x < mWidth; x++)
+	{
+		set = findSet(mSets[x]);
+
+		mSets[x] = set;
+		mLast[set] = x;
+		mHasDown[set] = 0;
+	}
+
+	for (unsigned int x = 0; x < mWidth; x++)
+	{
+		set = mSets[x];
+
+		if (random.nextBool() || (mLast[set] == x && !mHasDown[set]))
+		{
+			row[x] |= RDGMaze::CELL_DOWN;
+			mHasDown[set] = 1;
+		}
+		else
+			mSets[x] = NO_SET;
+	}
+}
+
+
+void RDGEllerRows::finish(uint8_t* row, RDGRandom& random)
+{
+	beginRow();
+	joinRow(row, random, true);
+	reset();
+}
+
+
+void RDGEllerRows::beginRow()
+{
+	unsigned int count = 0;
+
+	// Renumber the sets carried down from the last row, then give every other
+	// cell a set of its own.  This keeps the set numbers below the width.
+	std::fill(mRemap.begin(), mRemap.end(), NO_SET);
+
+	for (unsigned int x = 0; x < mWidth; x++)
+	{
+		if (mSets[x] == NO_SET)
+			continue;
+
+		if (mRemap[mSets[x]] == NO_SET)
+			mRemap[mSets[x]] = count++;
+
+		mSets[x] = mRemap[mSets[x]];
+	}
+
+	for (unsigned int x = 0; x < mWidth; x++)
+	{
+		if (mSets[x] == NO_SET)
+			mSets[x] = count++;
+	}
+
+	for (unsigned int i = 0; i < count; i++)
+		mParents[i] = i;
+}
+
+
+void RDGEllerRows::joinRow(uint8_t* row, RDGRandom& random, bool all)
+{
+	unsigned int a;
+	unsigned int b;
+
+	for (unsigned int x = 0; x < mWidth; x++)
+		row[x] = 0;
+
+	for (unsigned int x = 0; x + 1 < mWidth; x++)
+	{
+		a = findSet(mSets[x]);
+		b = findSet(mSets[x + 1]);
+
+		if (a != b && (all || random.nextBool()))
+		{
+			row[x] |= RDGMaze::CELL_RIGHT;
+			mParents[b] = a;
+		}
+	}
+}
+
+
+unsigned int RDGEllerRows::findSet(unsigned int set)
+{
+	while (mParents[set] != set)
+	{
+		mParents[set] = mParents[mParents[set]];
+		set = mParents[set];
+	}
+
+	return set;
+}
+
+
+void RDGEller::carve(RDGMaze& maze, const RDGRegion& region, RDGRandom& random) const
+{
+	if (region.width == 0 || region.height == 0)
+		return;
+
+	uint8_t* cells = maze.getCells();
+	const size_t stride = maze.getWidth();
+
+	RDGEllerRows rows(region.width);
+	vector<uint8_t> row(region.width);
+
+	for (unsigned int y = 0; y < region.height; y++)
+	{
+		uint8_t* target = &cells[(region.y + y) * stride + region.x];
+
+		if (y + 1 == region.height)
+			rows.finish(row.data(), random);
+		else
+			rows.next(row.data(), random);
+
+		for (unsigned int x = 0; x < region.width; x++)
+			target[x] |= row[x];
+	}
+}
+
+
+RDGTiledGenerator::RDGTiledGenerator(unique_ptr<RDGGenerator> tile, unsigned int tileSize,
+	unsigned int threads)
+	: mTile(std::move(tile))
+{
+	mTileSize = std::max(tileSize, 1u);
+	mThreads = threads;
+}
+
+
+void RDGTiledGenerator::carve(RDGMaze& maze, const RDGRegion& region, RDGRandom& random) const
+{
+	if (region.width == 0 || region.height == 0)
+		return;
+
+	const unsigned int tilesX = (region.width + mTileSize - 1) / mTileSize;
+	const unsigned int tilesY = (region.height + mTileSize - 1) / mTileSize;
+	const unsigned int tileCount = tilesX * tilesY;
+
+	vector<RDGRandom> streams;
+	vector<thread> workers;
+	atomic<unsigned int> nextTile(0);
+
+	unsigned int threads = mThreads;
+
+	if (threads == 0)
+		threads = std::max(thread::hardware_concurrency(), 1u);
+
+	threads = std::min(threads, tileCount);
+
+	// Streams are split off before any work starts, so each tile gets the same
+	// numbers however many threads there are
+	streams.reserve(tileCount);
+
+	for (unsigned int i = 0; i < tileCount; i++)
+		streams.push_back(random.split());
+
+	auto worker = [&]()
+	{
+		unsigned int tile;
+
+		while ((tile = nextTile++) < tileCount)
+		{
+			const unsigned int tx = (tile % tilesX) * mTileSize;
+			const unsigned int ty = (tile / tilesX) * mTileSize;
+			const RDGRegion tileRegion =
+			{
+				region.x + tx,
+				region.y + ty,
+				std::min(mTileSize, region.width - tx),
+				std::min(mTileSize, region.height - ty)
+			};
+
+			mTile->carve(maze, tileRegion, streams[tile]);
+		}
+	};
+
+	for (unsigned int i = 1; i < threads; i++)
+		workers.push_back(thread(worker));
+
+	worker();
+
+	for (thread& t : workers)
+		t.join();
+
+	// Join the tiles along a spanning tree, with one passage per tree edge
+	RDGMaze tiles(tilesX, tilesY);
+	RDGBacktracker().carve(tiles, random);
+
+	for (unsigned int ty = 0; ty < tilesY; ty++)
+	{
+		for (unsigned int tx = 0; tx < tilesX; tx++)
+		{
+			const unsigned int x = region.x + tx * mTileSize;
+			const unsigned int y = region.y + ty * mTileSize;
+			const unsigned int width = std::min(mTileSize, region.width - tx * mTileSize);
+			const unsigned int height = std::min(mTileSize, region.height - ty * mTileSize);
+
+			if (tiles.isOpen(tx, ty, NODE_RIGHT))
+				maze.open(x + width - 1, y + random.nextInt(height), NODE_RIGHT);
+
+			if (tiles.isOpen(tx, ty, NODE_DOWN))
+				maze.open(x + random.nextInt(width), y + height - 1, NODE_DOWN);
+		}
+	}
+}
@@ -0,0 +1,243 @@
+#pragma once
+
+//
+//	RDGGenerator.h by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include <memory>
+
+#include "RDGMaze.h"
+#include "RDGRandom.h"
+
+using std::unique_ptr;
+
+/**
+ *	Rectangle of cells within an RDGMaze
+ */
+struct RDGRegion
+{
+	unsigned int x;
+	unsigned int y;
+	unsigned int width;
+	unsigned int height;
+};
+
+/**
+ *	Base class for the maze carving algorithms used by RDGDungeon.
+
+ *	A generator carves a perfect maze (every cell reachable, with exactly one
+	route between any two cells) inside a region of an RDGMaze.  Generators only
+	write to the cells inside their region, and hold no state between calls, so
+	separate regions of the same maze can be carved on separate threads.
+ */
+class RDGGenerator
+{
+public:
+	enum class Algorithm
+	{
+		BACKTRACKER,	// Depth-first search - long, winding corridors
+		WILSON,			// Loop-erased random walks - unbiased, but slow to start
+		ELLER,			// Row by row, in memory proportional to the width
+		SIDEWINDER,		// Row by row, with a straight corridor along the top
+		GROWING_TREE,	// Mix of depth-first and random (Prim-like) selection
+		TILED			// Backtracker tiles carved in parallel, then stitched
+	};
+
+	virtual ~RDGGenerator() {}
+
+	/**
+	 *	Carve a maze through every cell in the maze
+
+	 *	@param maze : Maze to carve.  All passages should be closed.
+	 *	@param random : Source of random numbers
+	 */
+	void carve(RDGMaze& maze, RDGRandom& random) const;
+
+	/**
+	 *	Carve a maze through every cell in a region of the maze
+
+	 *	@param maze : Maze to carve.  All passages in the region should be closed.
+	 *	@param region : Region of the maze to carve
+	 *	@param random : Source of random numbers
+	 */
+	virtual void carve(RDGMaze& maze, const RDGRegion& region, RDGRandom& random) const = 0;
+
+	/**
+	 *	Create a generator using one of the built-in algorithms
+
+	 *	@param algorithm : Algorithm the generator should use
+
+	 *	@return the new generator
+	 */
+	static unique_ptr<RDGGenerator> create(Algorithm algorithm);
+
+	/**
+	 *	@return the name of an algorithm, for display
+	 */
+	static const char* getName(Algorithm algorithm);
+};
+
+
+/**
+ *	Iterative depth-first search (recursive backtracker).  The way back is stored
+	in each cell, so the search needs no stack of its own.
+
+ *	Carves about 30 million cells a second on one core, so an 8192 x 8192 maze
+	takes over two seconds.  Use RDGTiledGenerator to carve large mazes faster
+	on more than one core.
+ */
+class RDGBacktracker : public RDGGenerator
+{
+public:
+	using RDGGenerator::carve;
+	void carve(RDGMaze& maze, const RDGRegion& region, RDGRandom& random) const override;
+};
+
+
+/**
+ *	Wilson's algorithm.  Random walks from each unvisited cell until they hit the
+	maze, with loops erased by overwriting the direction stored in each cell.
+	Every possible maze is equally likely, but the first walks are long.
+ */
+class RDGWilson : public RDGGenerator
+{
+public:
+	using RDGGenerator::carve;
+	void carve(RDGMaze& maze, const RDGRegion& region, RDGRandom& random) const override;
+};
+
+
+/**
+ *	Sidewinder.  Carves each row as a series of runs, and opens one passage up
+	from each run.  Needs no memory, but leaves a straight corridor along the
+	first row.
+ */
+class RDGSidewinder : public RDGGenerator
+{
+public:
+	using RDGGenerator::carve;
+	void carve(RDGMaze& maze, const RDGRegion& region, RDGRandom& random) const override;
+};
+
+
+/**
+ *	Growing Tree.  Keeps a list of active cells, and picks either the newest or a
+	random one to grow from.
+
+ *	@param newest : Chance (0 to 1) of growing from the newest cell.  1 behaves
+		like the backtracker, 0 like Prim's algorithm.
+ */
+class RDGGrowingTree : public RDGGenerator
+{
+public:
+	RDGGrowingTree(float newest = 0.75f) : mNewest(newest) {}
+
+	using RDGGenerator::carve;
+	void carve(RDGMaze& maze, const RDGRegion& region, RDGRandom& random) const override;
+
+protected:
+	float mNewest;
+};
+
+
+/**
+ *	Eller's algorithm, producing one row of cells at a time.
+
+ *	Only the sets of the current row are remembered, so memory is proportional
+	to the width, and rows can be requested forever for a dungeon of unbounded
+	height.  Call finish() for the last row to join its remaining sets.
+ */
+class RDGEllerRows
+{
+public:
+	RDGEllerRows(unsigned int width);
+
+	/**
+	 *	Carve the next row
+
+	 *	@param row : Receives width cells, holding RDGMaze::CELL_RIGHT and
+			RDGMaze::CELL_DOWN flags
+	 *	@param random : Source of random numbers
+	 */
+	void next(uint8_t* row, RDGRandom& random);
+
+	/**
+	 *	Carve the final row, joining every set so the maze is closed off
+
+	 *	@param row : Receives width cells.  No CELL_DOWN flags will be set.
+	 *	@param random : Source of random numbers
+	 */
+	void finish(uint8_t* row, RDGRandom& random);
+
+	/**
+	 *	Start again from an empty first row
+	 */
+	void reset();
+
+protected:
+	static const unsigned int NO_SET = ~0u;
+
+	unsigned int mWidth;
+
+	vector<unsigned int> mSets;
+	vector<unsigned int> mParents;
+	vector<unsigned int> mRemap;
+	vector<unsigned int> mLast;
+	vector<uint8_t> mHasDown;
+
+	void beginRow();
+	void joinRow(uint8_t* row, RDGRandom& random, bool all);
+	unsigned int findSet(unsigned int set);
+};
+
+
+/**
+ *	Eller's algorithm, applied to a region of a maze one row at a time
+ */
+class RDGEller : public RDGGenerator
+{
+public:
+	using RDGGenerator::carve;
+	void carve(RDGMaze& maze, const RDGRegion& region, RDGRandom& random) const override;
+};
+
+
+/**
+ *	Splits the region into square tiles, and carves each tile on a pool of
+	worker threads using another generator.  A random spanning tree over the
+	tiles then decides where to open a single passage between neighbouring
+	tiles, so the result is still a perfect maze.
+
+ *	Each tile gets its own random stream, split in order from the caller's
+	random source, so the output does not depend on the number of threads.
+
+ *	On one thread it is no faster than the backtracker on its own.  Only the
+	tiles run in parallel, so it needs several cores to carve 8192 x 8192 in
+	under a second.
+ */
+class RDGTiledGenerator : public RDGGenerator
+{
+public:
+	/**
+	 *	@param tile : Generator used to carve each tile
+	 *	@param tileSize : Width and height of each tile, in cells
+	 *	@param threads : Number of worker threads.  0 uses one per hardware thread.
+	 */
+	RDGTiledGenerator(unique_ptr<RDGGenerator> tile, unsigned int tileSize = 256,
+		unsigned int threads = 0);
+
+	using RDGGenerator::carve;
+	void carve(RDGMaze& maze, const RDGRegion& region, RDGRandom& random) const override;
+
+protected:
+	unique_ptr<RDGGenerator> mTile;
+	unsigned int mTileSize;
+	unsigned int mThreads;
+};
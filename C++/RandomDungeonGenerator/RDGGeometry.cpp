@@ -0,0 +1,307 @@
+//
+//	RDGGeometry.cpp by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGGeometry.h"
+
+
+namespace RDGGeometry
+{
+	enum class Face
+	{
+		TOP,
+		LEFT,
+		RIGHT,
+		FRONT
+	};
+
+
+	/**
+	 *	Output for the counting pass - only totals up the quads
+	 */
+	struct _counter
+	{
+		unsigned int quads = 0;
+
+		void quad(Face, unsigned int, unsigned int, unsigned int, unsigned int)
+		{
+			quads++;
+		}
+	};
+
+
+	/**
+	 *	Output for the writing pass - writes each quad straight into the model data
+	 */
+	struct _writer
+	{
+		nModelData& data;
+		unsigned int element = 0;
+		float* vertex;
+		float* uv;
+		unsigned int* index;
+
+		_writer(nModelData& target) : data(target)
+		{
+			vertex = data.vertices;
+			uv = data.uvs;
+			index = data.indices;
+		}
+
+		void point(float x, float y, float z, float u, float v)
+		{
+			*vertex++ = x;
+			*vertex++ = y;
+			*vertex++ = z;
+
+			*uv++ = u;
+			*uv++ = v;
+		}
+
+		/**
+		 *	Write a quad covering tiles x0 to x1 and z0 to z1 (inclusive).  UVs are
+			scaled by the size of the quad so the texture tiles once per wall tile.
+		 */
+		void quad(Face face, unsigned int x0, unsigned int z0, unsigned int x1, unsigned int z1)
+		{
+			const float left = x0 - 0.5f;
+			const float right = x1 + 0.5f;
+			const float back = z0 - 0.5f;
+			const float front = z1 + 0.5f;
+			const float width = static_cast<float>(x1 - x0 + 1);
+			const float depth = static_cast<float>(z1 - z0 + 1);
+
+			switch (face)
+			{
+			case Face::TOP:
+				point(left, 0.5f, front, 0, 0);
+				point(right, 0.5f, front, width, 0);
+				point(left, 0.5f, back, 0, depth);
+				point(right, 0.5f, back, width, depth);
+				break;
+
+			case Face::LEFT:
+				point(left, -0.5f, back, 0, 0);
+				point(left, -0.5f, front, depth, 0);
+				point(left, 0.5f, back, 0, 1);
+				point(left, 0.5f, front, depth, 1);
+				break;
+
+			case Face::RIGHT:
+				point(right, -0.5f, front, 0, 0);
+				point(right, -0.5f, back, depth, 0);
+				point(right, 0.5f, front, 0, 1);
+				point(right, 0.5f, back, depth, 1);
+				break;
+
+			case Face::FRONT:
+				point(left, -0.5f, front, 0, 0);
+				point(right, -0.5f, front, width, 0);
+				point(left, 0.5f, front, 0, 1);
+				point(right, 0.5f, front, width, 1);
+				break;
+			}
+
+			*index++ = element;
+			*index++ = element + 3;
+			*index++ = element + 2;
+			*index++ = element;
+			*index++ = element + 1;
+			*index++ = element + 3;
+
+			element += 4;
+		}
+	};
+
+
+	/**
+	 *	Greedy mesh of a region of a layout.  Wall tops are merged into maximal
+		rectangles, and each exposed side is merged into the longest run along
+		its row or column.
+
+	 *	@param layout : Layout to mesh
+	 *	@param region : Tiles to mesh
+	 *	@param remaining : Scratch layout the size of the region, used to mark
+			tops already covered
+	 *	@param out : Receives each quad
+	 */
+	template <class Output>
+	static void mesh(const RDGLayout& layout, const RDGRegion& region, RDGLayout& remaining,
+		Output& out)
+	{
+		const unsigned int width = layout.getWidth();
+		const unsigned int height = layout.getHeight();
+		const unsigned int left = region.x;
+		const unsigned int top = region.y;
+		const unsigned int right = region.x + region.width;
+		const unsigned int bottom = region.y + region.height;
+
+		unsigned int end;
+
+		if (region.width == width && region.height == height)
+			remaining = layout;
+		else
+		{
+			remaining.resize(region.width, region.height);
+
+			for (unsigned int i = 0; i < region.height; i++)
+			{
+				for (unsigned int j = 0; j < region.width; j++)
+					remaining.setWall(j, i, layout.isWall(left + j, top + i));
+			}
+		}
+
+		// Tops - grow each rectangle as wide as possible, then as deep as possible
+		for (unsigned int i = 0; i < region.height; i++)
+		{
+			for (unsigned int j = 0; j < region.width; j++)
+			{
+				if (!remaining.isWall(j, i))
+					continue;
+
+				unsigned int last = j;
+				unsigned int lowest = i;
+
+				while (last + 1 < region.width && remaining.isWall(last + 1, i))
+					last++;
+
+				while (lowest + 1 < region.height)
+				{
+					unsigned int k = j;
+
+					while (k <= last && remaining.isWall(k, lowest + 1))
+						k++;
+
+					if (k <= last)
+						break;
+
+					lowest++;
+				}
+
+				for (unsigned int z = i; z <= lowest; z++)
+				{
+					for (unsigned int x = j; x <= last; x++)
+						remaining.setWall(x, z, false);
+				}
+
+				out.quad(Face::TOP, left + j, top + i, left + last, top + lowest);
+
+				j = last;
+			}
+		}
+
+		// Left and right sides, in runs down each column
+		for (unsigned int j = left; j < right; j++)
+		{
+			for (unsigned int i = top; i < bottom; i = end)
+			{
+				end = i + 1;
+
+				if (!layout.isWall(j, i) || (j > 0 && layout.isWall(j - 1, i)))
+					continue;
+
+				while (end < bottom && layout.isWall(j, end) && !(j > 0 && layout.isWall(j - 1, end)))
+					end++;
+
+				out.quad(Face::LEFT, j, i, j, end - 1);
+			}
+
+			for (unsigned int i = top; i < bottom; i = end)
+			{
+				end = i + 1;
+
+				if (!layout.isWall(j, i) || (j + 1 < width && layout.isWall(j + 1, i)))
+					continue;
+
+				while (end < bottom && layout.isWall(j, end) &&
+					!(j + 1 < width && layout.isWall(j + 1, end)))
+					end++;
+
+				out.quad(Face::RIGHT, j, i, j, end - 1);
+			}
+		}
+
+		// Fronts, in runs along each row
+		for (unsigned int i = top; i < bottom; i++)
+		{
+			for (unsigned int j = left; j < right; j = end)
+			{
+				end = j + 1;
+
+				if (!layout.isWall(j, i) || (i + 1 < height && layout.isWall(j, i + 1)))
+					continue;
+
+				while (end < right && layout.isWall(end, i) &&
+					!(i + 1 < height && layout.isWall(end, i + 1)))
+					end++;
+
+				out.quad(Face::FRONT, j, i, end - 1, i);
+			}
+		}
+	}
+
+
+	void build(const RDGLayout& layout, nModelData& data)
+	{
+		build(layout, { 0, 0, layout.getWidth(), layout.getHeight() }, data);
+	}
+
+
+	void build(const RDGLayout& layout, const RDGRegion& region, nModelData& data)
+	{
+		RDGLayout remaining;
+		_counter counter;
+
+		// Count first, so the arrays are allocated once at their exact size
+		mesh(layout, region, remaining, counter);
+
+		data.elementCount = counter.quads * 4;
+		data.indexCount = counter.quads * 6;
+
+		data.vertices = DBG_NEW float[data.elementCount * 3];
+		data.uvs = DBG_NEW float[data.elementCount * 2];
+		data.indices = DBG_NEW unsigned int[data.indexCount];
+
+		_writer writer(data);
+
+		mesh(layout, region, remaining, writer);
+	}
+
+
+	unsigned int countTileFaces(const RDGLayout& layout)
+	{
+		const unsigned int width = layout.getWidth();
+		const unsigned int height = layout.getHeight();
+
+		unsigned int faces = 0;
+
+		for (unsigned int i = 0; i < height; i++)
+		{
+			for (unsigned int j = 0; j < width; j++)
+			{
+				if (!layout.isWall(j, i))
+					continue;
+
+				faces++;
+
+				if (j == 0 || !layout.isWall(j - 1, i))
+					faces++;
+
+				if (j == width - 1 || !layout.isWall(j + 1, i))
+					faces++;
+
+				if (i == height - 1 || !layout.isWall(j, i + 1))
+					faces++;
+			}
+		}
+
+		return faces;
+	}
+}
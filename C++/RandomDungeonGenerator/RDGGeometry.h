@@ -0,0 +1,60 @@
+#pragma once
+
+//
+//	RDGGeometry.h by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include <NovaStage.h>
+
+#include "RDGGenerator.h"
+#include "RDGLayout.h"
+
+/**
+ *	Converts dungeon layouts into wall geometry
+ */
+namespace RDGGeometry
+{
+	/**
+	 *	Build the wall geometry for a layout.  Each wall tile is a unit cube
+		centred on its tile position, with faces only where they can be seen.
+
+	 *	Neighbouring faces in the same plane are merged into larger quads, with
+		UVs running past 1 so the texture repeats once per tile.  The texture
+		must use repeat wrapping.
+
+	 *	@param layout : Layout to build the walls of
+	 *	@param data : Receives the geometry.  The arrays are allocated with DBG_NEW,
+			at exactly the size needed.
+	 */
+	void build(const RDGLayout& layout, nModelData& data);
+
+	/**
+	 *	Build the wall geometry for a rectangle of a layout, so a large layout can
+		be split into meshes which are rebuilt separately.  Faces along the edge
+		of the rectangle look at the tiles outside it, so the meshes fit together
+		without gaps or hidden faces.  Vertices are in the same space as the
+		whole layout's.
+
+	 *	@param layout : Layout to build the walls of
+	 *	@param region : Tiles to build
+	 *	@param data : Receives the geometry, allocated as for build()
+	 */
+	void build(const RDGLayout& layout, const RDGRegion& region, nModelData& data);
+
+	/**
+	 *	Count the faces the layout would need with one quad per visible tile face,
+		for comparison with the merged geometry
+
+	 *	@param layout : Layout to count the faces of
+
+	 *	@return the number of unmerged quads
+	 */
+	unsigned int countTileFaces(const RDGLayout& layout);
+}
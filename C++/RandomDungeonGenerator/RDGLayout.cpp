@@ -0,0 +1,133 @@
+//
+//	RDGLayout.cpp by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGLayout.h"
+
+#include <algorithm>
+
+
+RDGLayout::RDGLayout()
+{
+	mWidth = 0;
+	mHeight = 0;
+	mStride = 0;
+}
+
+
+RDGLayout::RDGLayout(unsigned int width, unsigned int height)
+{
+	resize(width, height);
+}
+
+
+void RDGLayout::resize(unsigned int width, unsigned int height)
+{
+	mWidth = width;
+	mHeight = height;
+	mStride = (width + 63) / 64;
+
+	mWords.assign(static_cast<size_t>(mStride) * height, 0);
+}
+
+
+void RDGLayout::fillRow(unsigned int y)
+{
+	uint64_t* row = getRow(y);
+
+	for (unsigned int i = 0; i < mStride; i++)
+		row[i] = ~static_cast<uint64_t>(0);
+
+	// Keep the unused bits past the end of the row clear
+	if (mWidth % 64 != 0)
+		row[mStride - 1] = (static_cast<uint64_t>(1) << (mWidth % 64)) - 1;
+}
+
+
+void RDGLayout::setRun(unsigned int x0, unsigned int x1, unsigned int y, bool wall)
+{
+	uint64_t* row = getRow(y);
+
+	for (unsigned int word = x0 >> 6; word <= (x1 >> 6); word++)
+	{
+		uint64_t mask = ~static_cast<uint64_t>(0);
+
+		if (word == (x0 >> 6))
+			mask &= ~static_cast<uint64_t>(0) << (x0 & 63);
+
+		if (word == (x1 >> 6))
+			mask &= ~static_cast<uint64_t>(0) >> (63 - (x1 & 63));
+
+		row[word] = wall ? (row[word] | mask) : (row[word] & ~mask);
+	}
+}
+
+
+unsigned int RDGLayout::findNext(unsigned int x, unsigned int y, bool wall) const
+{
+	if (x >= mWidth)
+		return mWidth;
+
+	const uint64_t* row = getRow(y);
+	unsigned int word = x >> 6;
+	uint64_t bits = (wall ? row[word] : ~row[word]) & (~static_cast<uint64_t>(0) << (x & 63));
+
+	while (bits == 0)
+	{
+		if (++word == mStride)
+			return mWidth;
+
+		bits = wall ? row[word] : ~row[word];
+	}
+
+	// The unused bits past the end of the row read as floors
+	return std::min(word * 64 + lowestBit(bits), mWidth);
+}
+
+
+void RDGLayout::build(const RDGMaze& maze, bool closed)
+{
+	const unsigned int cellsX = maze.getWidth();
+	const unsigned int cellsY = maze.getHeight();
+	const unsigned int edge = closed ? 1 : 0;
+
+	resize(cellsX * 2 + edge, cellsY * 2 + edge);
+
+	if (mWidth == 0 || mHeight == 0)
+		return;
+
+	fillRow(0);
+
+	for (unsigned int y = 0; y < cellsY; y++)
+	{
+		const unsigned int row = y * 2 + 1;
+
+		// Row of cells, with the walls between them
+		setWall(0, row, true);
+
+		for (unsigned int x = 0; x < cellsX; x++)
+		{
+			if (x * 2 + 2 < mWidth)
+				setWall(x * 2 + 2, row, !maze.isOpen(x, y, NODE_RIGHT));
+		}
+
+		if (row + 1 == mHeight)
+			break;
+
+		// Row of walls below the cells, with the pillars between them
+		fillRow(row + 1);
+
+		for (unsigned int x = 0; x < cellsX; x++)
+		{
+			if (maze.isOpen(x, y, NODE_DOWN))
+				setWall(x * 2 + 1, row + 1, false);
+		}
+	}
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+//
+//	RDGLayout.h by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGMaze.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ *	Position of a tile in an RDGLayout
+ */
+struct RDGPoint
+{
+	unsigned int x;
+	unsigned int y;
+};
+
+/**
+ *	Grid of wall and floor tiles, which the dungeon geometry is built from.
+
+ *	Tiles are packed one bit each (set for a wall) into 64-bit words, with
+	every row starting on a new word.
+ */
+class RDGLayout
+{
+public:
+	RDGLayout();
+	RDGLayout(unsigned int width, unsigned int height);
+
+	/**
+	 *	Resize the layout, making every tile a floor
+
+	 *	@param width : Number of tiles in the X axis
+	 *	@param height : Number of tiles in the Y axis
+	 */
+	void resize(unsigned int width, unsigned int height);
+
+	/**
+	 *	Build the layout for a maze.  Each cell becomes a floor tile, surrounded
+		by wall tiles which are removed wherever a passage is open.  The layout
+		is resized to (2 * width + 1) by (2 * height + 1) tiles.
+
+	 *	@param maze : Carved maze to build the layout from
+	 *	@param closed : If false, the walls along the right and bottom edges are
+			left off (making the layout 2 * width by 2 * height tiles), so the
+			layout can be placed next to another one
+	 */
+	void build(const RDGMaze& maze, bool closed = true);
+
+	bool isWall(unsigned int x, unsigned int y) const
+	{
+		return (mWords[y * mStride + (x >> 6)] >> (x & 63)) & 1;
+	}
+
+	void setWall(unsigned int x, unsigned int y, bool wall)
+	{
+		uint64_t& word = mWords[y * mStride + (x >> 6)];
+		const uint64_t bit = static_cast<uint64_t>(1) << (x & 63);
+
+		word = wall ? (word | bit) : (word & ~bit);
+	}
+
+	/**
+	 *	Make a whole row of tiles into walls
+	 */
+	void fillRow(unsigned int y);
+
+	/**
+	 *	Set a run of tiles along a row, a word at a time
+
+	 *	@param x0 : First tile of the run
+	 *	@param x1 : Last tile of the run (inclusive)
+	 *	@param y : Row of the run
+	 *	@param wall : true to make the tiles walls, false for floors
+	 */
+	void setRun(unsigned int x0, unsigned int x1, unsigned int y, bool wall);
+
+	/**
+	 *	Find the next wall or floor along a row, a word at a time
+
+	 *	@param x : Tile to start looking from (inclusive)
+	 *	@param y : Row to look along
+	 *	@param wall : true to find a wall, false to find a floor
+
+	 *	@return the X position of the tile, or the width of the layout if there is none
+	 */
+	unsigned int findNext(unsigned int x, unsigned int y, bool wall) const;
+
+	unsigned int getWidth() const { return mWidth; }
+	unsigned int getHeight() const { return mHeight; }
+
+	/**
+	 *	@return the number of 64-bit words in each row
+	 */
+	unsigned int getStride() const { return mStride; }
+
+	uint64_t* getRow(unsigned int y) { return &mWords[y * mStride]; }
+	const uint64_t* getRow(unsigned int y) const { return &mWords[y * mStride]; }
+
+	/**
+	 *	@return the number of bytes used to store the tiles
+	 */
+	size_t getMemoryUsage() const { return mWords.capacity() * sizeof(uint64_t); }
+
+	/**
+	 *	@return the index of the lowest set bit.  bits must not be 0.
+	 */
+	static unsigned int lowestBit(uint64_t bits)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, bits);
+		return index;
+#else
+		return __builtin_ctzll(bits);
+#endif
+	}
+
+	/**
+	 *	@return the index of the highest set bit.  bits must not be 0.
+	 */
+	static unsigned int highestBit(uint64_t bits)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse64(&index, bits);
+		return index;
+#else
+		return 63 - __builtin_clzll(bits);
+#endif
+	}
+
+protected:
+	unsigned int mWidth;
+	unsigned int mHeight;
+	unsigned int mStride;
+
+	vector<uint64_t> mWords;
+};
@@ -0,0 +1,504 @@
+//
+//	RDGLayoutGenerator.cpp by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGLayoutGenerator.h"
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+
+unique_ptr<RDGLayoutGenerator> RDGLayoutGenerator::create(Style style)
+{
+	switch (style)
+	{
+	case Style::ROOMS:
+		return unique_ptr<RDGLayoutGenerator>(new RDGRoomLayout());
+	case Style::CAVES:
+		return unique_ptr<RDGLayoutGenerator>(new RDGCaveLayout());
+	case Style::MAZE:
+	default:
+		return unique_ptr<RDGLayoutGenerator>(new RDGMazeLayout());
+	}
+}
+
+
+const char* RDGLayoutGenerator::getName(Style style)
+{
+	switch (style)
+	{
+	case Style::MAZE:
+		return "Maze";
+	case Style::ROOMS:
+		return "Rooms";
+	case Style::CAVES:
+		return "Caves";
+	}
+
+	return "Unknown";
+}
+
+
+RDGMazeLayout::RDGMazeLayout(RDGGenerator::Algorithm algorithm)
+{
+	mGenerator = RDGGenerator::create(algorithm);
+}
+
+
+void RDGMazeLayout::generate(RDGLayout& layout, unsigned int width, unsigned int height,
+	RDGRandom& random) const
+{
+	RDGMaze maze(width / 2, height / 2);
+
+	mGenerator->carve(maze, random);
+	layout.build(maze);
+}
+
+
+RDGRoomLayout::RDGRoomLayout(unsigned int minRoom, unsigned int maxRoom)
+{
+	mMinRoom = std::max(minRoom, 1u);
+	mMaxRoom = std::max(maxRoom, mMinRoom);
+}
+
+
+void RDGRoomLayout::generate(RDGLayout& layout, unsigned int width, unsigned int height,
+	RDGRandom& random) const
+{
+	layout.resize(width, height);
+
+	for (unsigned int y = 0; y < height; y++)
+		layout.fillRow(y);
+
+	// Everything inside the outer wall
+	if (width > 2 && height > 2)
+		split(layout, { 1, 1, width - 2, height - 2 }, random);
+}
+
+
+RDGPoint RDGRoomLayout::split(RDGLayout& layout, const RDGRegion& region, RDGRandom& random) const
+{
+	// Each part holds a room with a wall either side, so rooms never touch
+	const unsigned int minPart = mMinRoom + 2;
+	const unsigned int maxPart = mMaxRoom + 2;
+
+	const bool splitX = region.width > maxPart && region.width >= minPart * 2;
+	const bool splitY = region.height > maxPart && region.height >= minPart * 2;
+
+	if (splitX || splitY)
+	{
+		// Split across the longer side, so the parts stay roughly square
+		const bool across = splitX && (!splitY || region.width >= region.height);
+		const unsigned int length = across ? region.width : region.height;
+		const unsigned int at = minPart + random.nextInt(length - minPart * 2 + 1);
+
+		RDGRegion first = region;
+		RDGRegion second = region;
+
+		if (across)
+		{
+			first.width = at;
+			second.x += at;
+			second.width -= at;
+		}
+		else
+		{
+			first.height = at;
+			second.y += at;
+			second.height -= at;
+		}
+
+		const RDGPoint a = split(layout, first, random);
+		const RDGPoint b = split(layout, second, random);
+
+		// L-shaped corridor between the two halves, bending one way or the other
+		const RDGPoint bend = random.nextBool() ? RDGPoint{ b.x, a.y } : RDGPoint{ a.x, b.y };
+
+		layout.setRun(std::min(a.x, bend.x), std::max(a.x, bend.x), a.y, false);
+		layout.setRun(std::min(b.x, bend.x), std::max(b.x, bend.x), b.y, false);
+
+		for (unsigned int y = std::min(a.y, bend.y); y <= std::max(a.y, bend.y); y++)
+			layout.setWall(a.x, y, false);
+
+		for (unsigned int y = std::min(b.y, bend.y); y <= std::max(b.y, bend.y); y++)
+			layout.setWall(b.x, y, false);
+
+		// Pass on a room from either side, so corridors fan out across the rooms
+		return random.nextBool() ? a : b;
+	}
+
+	// Small enough for a single room.  Regions too small for a whole room get
+	// whatever fits.
+	const unsigned int spaceX = region.width > 2 ? region.width - 2 : 1;
+	const unsigned int spaceY = region.height > 2 ? region.height - 2 : 1;
+	const unsigned int roomWidth = std::min(mMinRoom + random.nextInt(mMaxRoom - mMinRoom + 1), spaceX);
+	const unsigned int roomHeight = std::min(mMinRoom + random.nextInt(mMaxRoom - mMinRoom + 1), spaceY);
+	const unsigned int left = region.x + (region.width > 2 ? 1 : 0) + random.nextInt(spaceX - roomWidth + 1);
+	const unsigned int top = region.y + (region.height > 2 ? 1 : 0) + random.nextInt(spaceY - roomHeight + 1);
+
+	for (unsigned int y = top; y < top + roomHeight; y++)
+		layout.setRun(left, left + roomWidth - 1, y, false);
+
+	return { left + random.nextInt(roomWidth), top + random.nextInt(roomHeight) };
+}
+
+
+/**
+ *	Add up the walls around each tile of a word, and apply the automaton's rule.
+
+ *	The count for every tile is held bit-sliced: bit n of count[k] is bit k of
+	the count for tile n.  Adding the eight neighbours with full adders then
+	takes a handful of logic operations for every tile in the word at once.
+	Written once for plain 64-bit words and for the 256-bit AVX2 lanes.
+ */
+template <class T>
+static inline T smoothWord(T upW, T up, T upE, T west, T mid, T east, T downW, T down, T downE,
+	unsigned int birth, unsigned int survive)
+{
+	// Full adders over the first six neighbours, and a half adder over the last two
+	const T x0 = upW ^ up;
+	const T s0 = x0 ^ upE;
+	const T c0 = (upW & up) | (x0 & upE);
+
+	const T x1 = west ^ east;
+	const T s1 = x1 ^ downW;
+	const T c1 = (west & east) | (x1 & downW);
+
+	const T s2 = down ^ downE;
+	const T c2 = down & downE;
+
+	// Ones
+	const T x3 = s0 ^ s1;
+	const T bit0 = x3 ^ s2;
+	const T c3 = (s0 & s1) | (x3 & s2);
+
+	// Twos - c0, c1, c2 and c3
+	const T x4 = c0 ^ c1;
+	const T s4 = x4 ^ c2;
+	const T c4 = (c0 & c1) | (x4 & c2);
+	const T bit1 = s4 ^ c3;
+	const T c5 = s4 & c3;
+
+	// Fours and eights
+	const T bit2 = c4 ^ c5;
+	const T bit3 = c4 & c5;
+
+	const T count[] = { bit0, bit1, bit2, bit3 };
+
+	// Compare the counts against a constant, from the top bit down
+	auto atLeast = [&count](unsigned int k)
+	{
+		T greater = count[0] ^ count[0];
+		T equal = ~greater;
+
+		for (int bit = 3; bit >= 0; bit--)
+		{
+			if ((k >> bit) & 1)
+				equal = equal & count[bit];
+			else
+			{
+				greater = greater | (equal & count[bit]);
+				equal = equal & ~count[bit];
+			}
+		}
+
+		return greater | equal;
+	};
+
+	return (mid & atLeast(std::min(survive, 15u))) | (~mid & atLeast(std::min(birth, 15u)));
+}
+
+
+#if defined(__AVX2__)
+/**
+ *	Four words in an AVX2 register, with the operators smoothWord() needs
+ */
+struct _lanes
+{
+	__m256i v;
+
+	_lanes operator&(const _lanes& o) const { return { _mm256_and_si256(v, o.v) }; }
+	_lanes operator|(const _lanes& o) const { return { _mm256_or_si256(v, o.v) }; }
+	_lanes operator^(const _lanes& o) const { return { _mm256_xor_si256(v, o.v) }; }
+	_lanes operator~() const { return { _mm256_xor_si256(v, _mm256_set1_epi64x(-1)) }; }
+};
+
+
+static inline _lanes load(const uint64_t* words)
+{
+	return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words)) };
+}
+
+
+/**
+ *	@return the words, with every tile moved one place east (bit n + 1 is now bit n)
+ */
+static inline _lanes fromEast(const uint64_t* words)
+{
+	return { _mm256_or_si256(_mm256_srli_epi64(load(words).v, 1),
+		_mm256_slli_epi64(load(words + 1).v, 63)) };
+}
+
+
+/**
+ *	@return the words, with every tile moved one place west (bit n - 1 is now bit n)
+ */
+static inline _lanes fromWest(const uint64_t* words)
+{
+	return { _mm256_or_si256(_mm256_slli_epi64(load(words).v, 1),
+		_mm256_srli_epi64(load(words - 1).v, 63)) };
+}
+#endif
+
+
+/**
+ *	Run one step of the automaton over a padded grid.  Every row has a word of
+	walls either side, and there is a row of walls above and below, so the edge
+	of the layout needs no special case.
+
+ *	@param from : Grid to read
+ *	@param to : Grid to write
+ *	@param stride : Words in each row of the layout
+ *	@param height : Rows in the layout
+ */
+static void smooth(const vector<uint64_t>& from, vector<uint64_t>& to, unsigned int stride,
+	unsigned int height, unsigned int birth, unsigned int survive)
+{
+	const size_t padded = stride + 2;
+
+	for (unsigned int y = 1; y <= height; y++)
+	{
+		const uint64_t* up = &from[(y - 1) * padded];
+		const uint64_t* mid = &from[y * padded];
+		const uint64_t* down = &from[(y + 1) * padded];
+		uint64_t* out = &to[y * padded];
+
+		unsigned int i = 1;
+
+#if defined(__AVX2__)
+		for (; i + 3 <= stride; i += 4)
+		{
+			const _lanes result = smoothWord(
+				fromWest(up + i), load(up + i), fromEast(up + i),
+				fromWest(mid + i), load(mid + i), fromEast(mid + i),
+				fromWest(down + i), load(down + i), fromEast(down + i),
+				birth, survive);
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), result.v);
+		}
+#endif
+
+		for (; i <= stride; i++)
+		{
+			out[i] = smoothWord(
+				(up[i] << 1) | (up[i - 1] >> 63), up[i], (up[i] >> 1) | (up[i + 1] << 63),
+				(mid[i] << 1) | (mid[i - 1] >> 63), mid[i], (mid[i] >> 1) | (mid[i + 1] << 63),
+				(down[i] << 1) | (down[i - 1] >> 63), down[i], (down[i] >> 1) | (down[i + 1] << 63),
+				birth, survive);
+		}
+	}
+}
+
+
+/**
+ *	Wall in the outside edge of a padded grid, and the unused bits past the end
+	of each row
+ */
+static void closeEdges(vector<uint64_t>& grid, unsigned int width, unsigned int height)
+{
+	const unsigned int stride = (width + 63) / 64;
+	const size_t padded = stride + 2;
+	const uint64_t end = width % 64 == 0 ? 0 : ~((static_cast<uint64_t>(1) << (width % 64)) - 1);
+	const uint64_t last = static_cast<uint64_t>(1) << ((width - 1) & 63);
+
+	for (unsigned int y = 1; y <= height; y++)
+	{
+		uint64_t* row = &grid[y * padded];
+
+		if (y == 1 || y == height)
+		{
+			for (unsigned int i = 1; i <= stride; i++)
+				row[i] = ~static_cast<uint64_t>(0);
+		}
+
+		row[1] |= 1;
+		row[stride] |= last | end;
+	}
+}
+
+
+RDGCaveLayout::RDGCaveLayout(float fill, unsigned int steps, unsigned int birth,
+	unsigned int survive, bool connect)
+{
+	mFill = fill;
+	mSteps = steps;
+	mBirth = birth;
+	mSurvive = survive;
+	mConnect = connect;
+}
+
+
+void RDGCaveLayout::generate(RDGLayout& layout, unsigned int width, unsigned int height,
+	RDGRandom& random) const
+{
+	layout.resize(width, height);
+
+	if (width == 0 || height == 0)
+		return;
+
+	const unsigned int stride = layout.getStride();
+	const size_t padded = stride + 2;
+
+	// Chance of a wall, in 256ths
+	const unsigned int chance = static_cast<unsigned int>(std::min(std::max(mFill, 0.0f), 1.0f) * 256.0f);
+
+	vector<uint64_t> current(padded * (height + 2), ~static_cast<uint64_t>(0));
+	vector<uint64_t> next(current);
+
+	// Random fill, 64 tiles at a time.  Working up from the lowest bit of the
+	// chance, OR with a random word where the bit is set and AND where it is
+	// clear.  Each step halves the chance so far and adds that bit's half, so
+	// the highest bit, applied last, counts most, and each bit ends up set with
+	// a chance of exactly chance / 256.
+	for (unsigned int y = 1; y <= height; y++)
+	{
+		for (unsigned int i = 1; i <= stride; i++)
+		{
+			uint64_t bits = 0;
+
+			for (unsigned int bit = 0; bit < 8; bit++)
+				bits = ((chance >> bit) & 1) ? (bits | random.next()) : (bits & random.next());
+
+			current[y * padded + i] = chance >= 256 ? ~static_cast<uint64_t>(0) : bits;
+		}
+	}
+
+	closeEdges(current, width, height);
+
+	for (unsigned int step = 0; step < mSteps; step++)
+	{
+		smooth(current, next, stride, height, mBirth, mSurvive);
+		closeEdges(next, width, height);
+
+		current.swap(next);
+	}
+
+	// Copy into the layout, clearing the unused bits past the end of each row
+	const uint64_t end = width % 64 == 0 ? ~static_cast<uint64_t>(0) :
+		(static_cast<uint64_t>(1) << (width % 64)) - 1;
+
+	for (unsigned int y = 0; y < height; y++)
+	{
+		uint64_t* row = layout.getRow(y);
+
+		for (unsigned int i = 0; i < stride; i++)
+			row[i] = current[(y + 1) * padded + i + 1];
+
+		row[stride - 1] &= end;
+	}
+
+	if (mConnect)
+		keepLargest(layout);
+}
+
+
+void RDGCaveLayout::keepLargest(RDGLayout& layout) const
+{
+	const unsigned int width = layout.getWidth();
+	const unsigned int height = layout.getHeight();
+
+	struct _run
+	{
+		uint32_t start;
+		uint32_t end;
+	};
+
+	// Each run of floor along a row, and the first run of each row
+	vector<_run> runs;
+	vector<uint32_t> rows(height + 1);
+	vector<uint32_t> parents;
+
+	auto findRun = [&parents](uint32_t run)
+	{
+		while (parents[run] != run)
+		{
+			parents[run] = parents[parents[run]];
+			run = parents[run];
+		}
+
+		return run;
+	};
+
+	// Label the caves a run at a time, joining each run to the runs it overlaps
+	// in the row above
+	for (unsigned int y = 0; y < height; y++)
+	{
+		uint32_t above = y > 0 ? rows[y - 1] : 0;
+
+		rows[y] = static_cast<uint32_t>(runs.size());
+
+		for (unsigned int x = layout.findNext(0, y, false); x < width; )
+		{
+			const unsigned int end = layout.findNext(x, y, true);
+			const uint32_t run = static_cast<uint32_t>(runs.size());
+
+			runs.push_back({ x, end });
+			parents.push_back(run);
+
+			while (above < rows[y] && runs[above].end <= x)
+				above++;
+
+			for (uint32_t i = above; i < rows[y] && runs[i].start < end; i++)
+			{
+				const uint32_t a = findRun(i);
+				const uint32_t b = findRun(run);
+
+				if (a != b)
+					parents[std::max(a, b)] = std::min(a, b);
+			}
+
+			x = layout.findNext(end, y, false);
+		}
+	}
+
+	rows[height] = static_cast<uint32_t>(runs.size());
+
+	if (runs.empty())
+		return;
+
+	// Add up the size of each cave, at its first run
+	vector<uint64_t> sizes(runs.size(), 0);
+	uint32_t largest = 0;
+
+	for (uint32_t i = 0; i < runs.size(); i++)
+	{
+		const uint32_t cave = findRun(i);
+
+		sizes[cave] += runs[i].end - runs[i].start;
+
+		if (sizes[cave] > sizes[largest])
+			largest = cave;
+	}
+
+	// Walls everywhere, except the runs of the largest cave
+	for (unsigned int y = 0; y < height; y++)
+	{
+		layout.fillRow(y);
+
+		for (uint32_t i = rows[y]; i < rows[y + 1]; i++)
+		{
+			if (findRun(i) == largest)
+				layout.setRun(runs[i].start, runs[i].end - 1, y, false);
+		}
+	}
+}
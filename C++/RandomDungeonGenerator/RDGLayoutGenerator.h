@@ -0,0 +1,142 @@
+#pragma once
+
+//
+//	RDGLayoutGenerator.h by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGGenerator.h"
+#include "RDGLayout.h"
+
+/**
+ *	Base class for the generators which fill in the wall grid of an RDGDungeon.
+	Mazes are one style; rooms and caves write the grid directly.
+ */
+class RDGLayoutGenerator
+{
+public:
+	enum class Style
+	{
+		MAZE,	// Perfect maze, carved by an RDGGenerator
+		ROOMS,	// Rooms in a binary space partition, joined by corridors
+		CAVES	// Random fill smoothed by a cellular automaton
+	};
+
+	virtual ~RDGLayoutGenerator() {}
+
+	/**
+	 *	Generate a new layout
+
+	 *	@param layout : Receives the layout
+	 *	@param width : Number of tiles in the X axis.  Should be odd.
+	 *	@param height : Number of tiles in the Y axis.  Should be odd.
+	 *	@param random : Source of random numbers
+	 */
+	virtual void generate(RDGLayout& layout, unsigned int width, unsigned int height,
+		RDGRandom& random) const = 0;
+
+	/**
+	 *	Create a generator for one of the styles, with its default settings
+
+	 *	@param style : Style of layout to generate
+
+	 *	@return the new generator
+	 */
+	static unique_ptr<RDGLayoutGenerator> create(Style style);
+
+	/**
+	 *	@return the name of a style, for display
+	 */
+	static const char* getName(Style style);
+};
+
+
+/**
+ *	Layout of a perfect maze.  Each cell of the maze takes up every other tile.
+ */
+class RDGMazeLayout : public RDGLayoutGenerator
+{
+public:
+	/**
+	 *	@param algorithm : Algorithm used to carve the maze
+	 */
+	RDGMazeLayout(RDGGenerator::Algorithm algorithm = RDGGenerator::Algorithm::BACKTRACKER);
+
+	void generate(RDGLayout& layout, unsigned int width, unsigned int height,
+		RDGRandom& random) const override;
+
+protected:
+	unique_ptr<RDGGenerator> mGenerator;
+};
+
+
+/**
+ *	Rooms and corridors.  The layout is split in two, again and again, until
+	each part is small enough to hold one room.  Each split is then joined by
+	a corridor between a room on either side, so every room can be reached.
+ */
+class RDGRoomLayout : public RDGLayoutGenerator
+{
+public:
+	/**
+	 *	@param minRoom : Smallest width or height of a room, in tiles
+	 *	@param maxRoom : Largest width or height of a room, in tiles
+	 */
+	RDGRoomLayout(unsigned int minRoom = 3, unsigned int maxRoom = 8);
+
+	void generate(RDGLayout& layout, unsigned int width, unsigned int height,
+		RDGRandom& random) const override;
+
+protected:
+	unsigned int mMinRoom;
+	unsigned int mMaxRoom;
+
+	/**
+	 *	Split a region, or carve a room if it is small enough
+
+	 *	@return a floor tile in one of the rooms carved in the region
+	 */
+	RDGPoint split(RDGLayout& layout, const RDGRegion& region, RDGRandom& random) const;
+};
+
+
+/**
+ *	Caves.  Tiles start as walls or floors at random, then each step of a
+	cellular automaton turns a tile into a wall if enough of its 8 neighbours
+	are walls.
+
+ *	The grid is kept packed one bit per tile, and the neighbour counts are added
+	up bit by bit, so each step handles 64 tiles per instruction (256 with AVX2).
+ */
+class RDGCaveLayout : public RDGLayoutGenerator
+{
+public:
+	/**
+	 *	@param fill : Chance (0 to 1) of a tile starting as a wall
+	 *	@param steps : Number of smoothing steps
+	 *	@param birth : Neighbouring walls needed to turn a floor into a wall
+	 *	@param survive : Neighbouring walls needed for a wall to stay a wall
+	 *	@param connect : Fill in every cave but the largest, so every floor tile
+			can be reached
+	 */
+	RDGCaveLayout(float fill = 0.45f, unsigned int steps = 4, unsigned int birth = 5,
+		unsigned int survive = 4, bool connect = true);
+
+	void generate(RDGLayout& layout, unsigned int width, unsigned int height,
+		RDGRandom& random) const override;
+
+protected:
+	float mFill;
+	unsigned int mSteps;
+	unsigned int mBirth;
+	unsigned int mSurvive;
+	bool mConnect;
+
+	void keepLargest(RDGLayout& layout) const;
+};
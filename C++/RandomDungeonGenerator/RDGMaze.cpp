@@ -0,0 +1,86 @@
+//
+//	RDGMaze.cpp by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGMaze.h"
+
+
+RDGMaze::RDGMaze()
+{
+	mWidth = 0;
+	mHeight = 0;
+}
+
+
+RDGMaze::RDGMaze(unsigned int width, unsigned int height)
+{
+	resize(width, height);
+}
+
+
+void RDGMaze::resize(unsigned int width, unsigned int height)
+{
+	mWidth = width;
+	mHeight = height;
+
+	mCells.assign(static_cast<size_t>(width) * height, 0);
+}
+
+
+bool RDGMaze::isOpen(unsigned int x, unsigned int y, unsigned int direction) const
+{
+	const size_t index = static_cast<size_t>(y) * mWidth + x;
+
+	switch (direction)
+	{
+	case NODE_RIGHT:
+		return (mCells[index] & CELL_RIGHT) != 0;
+	case NODE_DOWN:
+		return (mCells[index] & CELL_DOWN) != 0;
+	case NODE_LEFT:
+		return x > 0 && (mCells[index - 1] & CELL_RIGHT) != 0;
+	case NODE_UP:
+		return y > 0 && (mCells[index - mWidth] & CELL_DOWN) != 0;
+	}
+
+	return false;
+}
+
+
+void RDGMaze::open(unsigned int x, unsigned int y, unsigned int direction)
+{
+	const size_t index = static_cast<size_t>(y) * mWidth + x;
+
+	switch (direction)
+	{
+	case NODE_RIGHT:
+		mCells[index] |= CELL_RIGHT;
+		break;
+	case NODE_DOWN:
+		mCells[index] |= CELL_DOWN;
+		break;
+	case NODE_LEFT:
+		mCells[index - 1] |= CELL_RIGHT;
+		break;
+	case NODE_UP:
+		mCells[index - mWidth] |= CELL_DOWN;
+		break;
+	}
+}
+
+
+void RDGMaze::release()
+{
+	mCells.clear();
+	mCells.shrink_to_fit();
+
+	mWidth = 0;
+	mHeight = 0;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+//
+//	RDGMaze.h by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using std::vector;
+
+static const unsigned int NODE_RIGHT = 0;
+static const unsigned int NODE_DOWN = 1;
+static const unsigned int NODE_LEFT = 2;
+static const unsigned int NODE_UP = 3;
+
+/**
+ *	Compact grid of maze cells, carved by an RDGGenerator to create the layout
+	of an RDGDungeon.
+
+ *	Each cell takes a single byte.  Only the right and down passages are stored
+	in a cell - the left and up passages belong to the neighbouring cell.  The
+	rest of the byte is scratch space for the generators: a visited flag, and
+	two bits holding a direction (the way back for the depth-first search, the
+	way out for Wilson's random walks).  This lets the generators keep their
+	working state inside the grid, so carving needs no memory beyond the cells
+	themselves.
+ */
+class RDGMaze
+{
+public:
+	RDGMaze();
+	RDGMaze(unsigned int width, unsigned int height);
+
+	/**
+	 *	Resize the maze, closing every passage
+
+	 *	@param width : Number of cells in the X axis
+	 *	@param height : Number of cells in the Y axis
+	 */
+	void resize(unsigned int width, unsigned int height);
+
+	/**
+	 *	Check if there is a passage leading out of a cell
+
+	 *	@param x : X position of the cell
+	 *	@param y : Y position of the cell
+	 *	@param direction : One of NODE_RIGHT, NODE_DOWN, NODE_LEFT or NODE_UP
+
+	 *	@return true if the passage is open
+	 */
+	bool isOpen(unsigned int x, unsigned int y, unsigned int direction) const;
+
+	/**
+	 *	Open the passage leading out of a cell.  The cell on the other side of
+		the passage must be inside the maze.
+
+	 *	@param x : X position of the cell
+	 *	@param y : Y position of the cell
+	 *	@param direction : One of NODE_RIGHT, NODE_DOWN, NODE_LEFT or NODE_UP
+	 */
+	void open(unsigned int x, unsigned int y, unsigned int direction);
+
+	/**
+	 *	Get direct access to the cells, for the generators.  Cells are stored
+		row by row, and hold the CELL_ flags below.
+	 */
+	uint8_t* getCells() { return mCells.data(); }
+
+	unsigned int getWidth() const { return mWidth; }
+	unsigned int getHeight() const { return mHeight; }
+
+	/**
+	 *	@return the number of bytes used to store the cells
+	 */
+	size_t getMemoryUsage() const { return mCells.capacity(); }
+
+	/**
+	 *	Free the memory used by the cells, leaving an empty maze
+	 */
+	void release();
+
+	static const uint8_t CELL_RIGHT = 0x01;
+	static const uint8_t CELL_DOWN = 0x02;
+	static const uint8_t CELL_VISITED = 0x04;
+	static const uint8_t CELL_DIRECTION_SHIFT = 3;
+	static const uint8_t CELL_DIRECTION = 0x18;
+
+protected:
+	unsigned int mWidth;
+	unsigned int mHeight;
+
+	vector<uint8_t> mCells;
+};
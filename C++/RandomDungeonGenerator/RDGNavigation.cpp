@@ -0,0 +1,536 @@
+//
+//	RDGNavigation.cpp by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGNavigation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using std::atomic;
+using std::thread;
+
+const unsigned int RDGNavigation::NO_PATH;
+
+static const int STEP_X[] = { 1, 0, -1, 0 };
+static const int STEP_Y[] = { 0, 1, 0, -1 };
+
+
+static inline uint32_t distance(uint32_t a, uint32_t b)
+{
+	return a > b ? a - b : b - a;
+}
+
+
+static inline uint32_t hashTile(uint32_t tile)
+{
+	tile *= 0x9e3779b1u;
+
+	return tile ^ (tile >> 16);
+}
+
+
+RDGDistanceField::RDGDistanceField()
+{
+	mWidth = 0;
+	mHeight = 0;
+	mTarget = { 0, 0 };
+}
+
+
+void RDGDistanceField::build(const RDGLayout& layout, RDGPoint target)
+{
+	mWidth = layout.getWidth();
+	mHeight = layout.getHeight();
+	mTarget = target;
+
+	mDistances.assign(static_cast<size_t>(mWidth) * mHeight, RDGNavigation::NO_PATH);
+
+	if (target.x >= mWidth || target.y >= mHeight || layout.isWall(target.x, target.y))
+		return;
+
+	// Breadth-first, one ring of tiles at a time, so only the edge of the search
+	// is held in memory
+	vector<uint32_t> frontier;
+	vector<uint32_t> next;
+	uint32_t steps = 0;
+
+	frontier.push_back(target.y * mWidth + target.x);
+	mDistances[frontier[0]] = 0;
+
+	while (!frontier.empty())
+	{
+		steps++;
+		next.clear();
+
+		for (uint32_t tile : frontier)
+		{
+			const uint32_t x = tile % mWidth;
+			const uint32_t y = tile / mWidth;
+
+			for (unsigned int d = 0; d < 4; d++)
+			{
+				const uint32_t nx = x + STEP_X[d];
+				const uint32_t ny = y + STEP_Y[d];
+
+				// Stepping off the left or top wraps around to a huge value
+				if (nx >= mWidth || ny >= mHeight || layout.isWall(nx, ny))
+					continue;
+
+				const uint32_t index = ny * mWidth + nx;
+
+				if (mDistances[index] != RDGNavigation::NO_PATH)
+					continue;
+
+				mDistances[index] = steps;
+				next.push_back(index);
+			}
+		}
+
+		frontier.swap(next);
+	}
+}
+
+
+bool RDGDistanceField::step(RDGPoint& point) const
+{
+	const uint32_t current = getDistance(point.x, point.y);
+
+	if (current == 0 || current == RDGNavigation::NO_PATH)
+		return false;
+
+	for (unsigned int d = 0; d < 4; d++)
+	{
+		const uint32_t nx = point.x + STEP_X[d];
+		const uint32_t ny = point.y + STEP_Y[d];
+
+		if (nx < mWidth && ny < mHeight && getDistance(nx, ny) == current - 1)
+		{
+			point = { nx, ny };
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+RDGNavigation::Workspace::Workspace()
+{
+	mEntries.resize(1024, { 0, 0, 0, 0 });
+	mMask = 1023;
+	mCount = 0;
+	mStamp = 0;
+}
+
+
+void RDGNavigation::Workspace::begin()
+{
+	mOpen.clear();
+	mCount = 0;
+
+	// Entries from older searches have an older stamp, so count as empty
+	if (++mStamp == 0)
+	{
+		for (_entry& entry : mEntries)
+			entry.stamp = 0;
+
+		mStamp = 1;
+	}
+}
+
+
+RDGNavigation::Workspace::_entry* RDGNavigation::Workspace::find(uint32_t tile)
+{
+	uint32_t i = hashTile(tile) & mMask;
+
+	while (mEntries[i].stamp == mStamp)
+	{
+		if (mEntries[i].tile == tile)
+			return &mEntries[i];
+
+		i = (i + 1) & mMask;
+	}
+
+	return nullptr;
+}
+
+
+RDGNavigation::Workspace::_entry* RDGNavigation::Workspace::insert(uint32_t tile)
+{
+	if ((mCount + 1) * 2 > mEntries.size())
+		grow();
+
+	uint32_t i = hashTile(tile) & mMask;
+
+	while (mEntries[i].stamp == mStamp)
+		i = (i + 1) & mMask;
+
+	mEntries[i] = { tile, mStamp, NO_PATH, tile };
+	mCount++;
+
+	return &mEntries[i];
+}
+
+
+void RDGNavigation::Workspace::grow()
+{
+	vector<_entry> old;
+
+	old.swap(mEntries);
+
+	mEntries.resize(old.size() * 2, { 0, 0, 0, 0 });
+	mMask = static_cast<uint32_t>(mEntries.size() - 1);
+
+	for (const _entry& entry : old)
+	{
+		if (entry.stamp != mStamp)
+			continue;
+
+		uint32_t i = hashTile(entry.tile) & mMask;
+
+		while (mEntries[i].stamp == mStamp)
+			i = (i + 1) & mMask;
+
+		mEntries[i] = entry;
+	}
+}
+
+
+RDGNavigation::RDGNavigation(const RDGLayout& layout)
+	: mLayout(layout)
+{
+
+}
+
+
+unsigned int RDGNavigation::findPath(RDGPoint start, RDGPoint goal, vector<RDGPoint>& path,
+	Workspace& workspace, bool jump) const
+{
+	path.clear();
+
+	if (!isFloor(start) || !isFloor(goal))
+		return NO_PATH;
+
+	for (const RDGDistanceField& field : mFields)
+	{
+		if (field.getTarget().x == goal.x && field.getTarget().y == goal.y)
+			return follow(field, start, path);
+	}
+
+	return search(start, goal, path, workspace, jump);
+}
+
+
+void RDGNavigation::findPaths(vector<RDGPathQuery>& queries, unsigned int threads, bool jump) const
+{
+	const unsigned int count = static_cast<unsigned int>(queries.size());
+
+	vector<thread> workers;
+	atomic<unsigned int> nextQuery(0);
+
+	if (threads == 0)
+		threads = std::max(thread::hardware_concurrency(), 1u);
+
+	threads = std::max(std::min(threads, count), 1u);
+
+	auto worker = [&]()
+	{
+		Workspace workspace;
+		unsigned int i;
+
+		while ((i = nextQuery++) < count)
+		{
+			RDGPathQuery& query = queries[i];
+
+			query.length = findPath(query.start, query.goal, query.path, workspace, jump);
+		}
+	};
+
+	for (unsigned int i = 1; i < threads; i++)
+		workers.push_back(thread(worker));
+
+	worker();
+
+	for (thread& t : workers)
+		t.join();
+}
+
+
+const RDGDistanceField& RDGNavigation::addTarget(RDGPoint target)
+{
+	mFields.emplace_back();
+	mFields.back().build(mLayout, target);
+
+	return mFields.back();
+}
+
+
+void RDGNavigation::clearTargets()
+{
+	mFields.clear();
+}
+
+
+unsigned int RDGNavigation::search(RDGPoint start, RDGPoint goal, vector<RDGPoint>& path,
+	Workspace& workspace, bool jump) const
+{
+	typedef Workspace::_entry _entry;
+	typedef Workspace::_open _open;
+
+	const uint32_t width = mLayout.getWidth();
+	const uint32_t height = mLayout.getHeight();
+	const uint32_t startTile = start.y * width + start.x;
+	const uint32_t goalTile = goal.y * width + goal.x;
+
+	vector<_open>& open = workspace.mOpen;
+
+	// Lowest score first, and the deepest of those, to head straight for the goal
+	// when several routes look equally good
+	auto later = [](const _open& a, const _open& b)
+	{
+		return a.score > b.score || (a.score == b.score && a.cost < b.cost);
+	};
+
+	workspace.begin();
+
+	workspace.insert(startTile)->cost = 0;
+	open.push_back({ distance(start.x, goal.x) + distance(start.y, goal.y), 0, startTile });
+
+	while (!open.empty())
+	{
+		std::pop_heap(open.begin(), open.end(), later);
+
+		const _open node = open.back();
+		open.pop_back();
+
+		const _entry* entry = workspace.find(node.tile);
+
+		// Already reached more cheaply since this was queued
+		if (entry->cost != node.cost)
+			continue;
+
+		if (node.tile == goalTile)
+			break;
+
+		const uint32_t x = node.tile % width;
+		const uint32_t y = node.tile / width;
+		const uint32_t px = entry->parent % width;
+		const uint32_t py = entry->parent / width;
+
+		for (unsigned int d = 0; d < 4; d++)
+		{
+			// Never head back the way we came
+			if ((STEP_X[d] > 0 && px > x) || (STEP_X[d] < 0 && px < x) ||
+				(STEP_Y[d] > 0 && py > y) || (STEP_Y[d] < 0 && py < y))
+				continue;
+
+			uint32_t nx = x;
+			uint32_t ny = y;
+
+			if (jump)
+			{
+				if (STEP_X[d] != 0 ? !jumpRow(x, y, STEP_X[d], goal, nx) :
+					!jumpColumn(x, y, STEP_Y[d], goal, ny))
+					continue;
+			}
+			else
+			{
+				nx += STEP_X[d];
+				ny += STEP_Y[d];
+
+				if (nx >= width || ny >= height || mLayout.isWall(nx, ny))
+					continue;
+			}
+
+			const uint32_t cost = node.cost + distance(nx, x) + distance(ny, y);
+			const uint32_t tile = ny * width + nx;
+
+			_entry* next = workspace.find(tile);
+
+			if (next == nullptr)
+				next = workspace.insert(tile);
+			else if (cost >= next->cost)
+				continue;
+
+			next->cost = cost;
+			next->parent = node.tile;
+
+			open.push_back({ cost + distance(nx, goal.x) + distance(ny, goal.y), cost, tile });
+			std::push_heap(open.begin(), open.end(), later);
+		}
+	}
+
+	const _entry* end = workspace.find(goalTile);
+
+	if (end == nullptr)
+		return NO_PATH;
+
+	// Walk back along the parents, then flip the path around
+	for (uint32_t tile = goalTile; ; tile = workspace.find(tile)->parent)
+	{
+		path.push_back({ tile % width, tile / width });
+
+		if (tile == startTile)
+			break;
+	}
+
+	std::reverse(path.begin(), path.end());
+
+	return end->cost;
+}
+
+
+unsigned int RDGNavigation::follow(const RDGDistanceField& field, RDGPoint start,
+	vector<RDGPoint>& path) const
+{
+	const unsigned int length = field.getDistance(start.x, start.y);
+
+	if (length == NO_PATH)
+		return NO_PATH;
+
+	RDGPoint point = start;
+	RDGPoint next = start;
+	int last = -1;
+
+	path.push_back(start);
+
+	// Only keep the corners, to match the waypoints from a search
+	while (field.step(next))
+	{
+		const int direction = next.x > point.x ? NODE_RIGHT : next.y > point.y ? NODE_DOWN :
+			next.x < point.x ? NODE_LEFT : NODE_UP;
+
+		if (last != -1 && direction != last)
+			path.push_back(point);
+
+		last = direction;
+		point = next;
+	}
+
+	if (last != -1)
+		path.push_back(point);
+
+	return length;
+}
+
+
+uint64_t RDGNavigation::stopBits(uint32_t y, uint32_t word, RDGPoint goal) const
+{
+	const uint32_t width = mLayout.getWidth();
+	uint64_t bits = mLayout.getRow(y)[word];
+
+	// Floor tiles with an opening above or below
+	if (y > 0)
+		bits |= ~mLayout.getRow(y - 1)[word];
+
+	if (y + 1 < mLayout.getHeight())
+		bits |= ~mLayout.getRow(y + 1)[word];
+
+	// Past the end of the row counts as a wall
+	if (word + 1 == mLayout.getStride() && width % 64 != 0)
+		bits |= ~((static_cast<uint64_t>(1) << (width % 64)) - 1);
+
+	if (goal.y == y && (goal.x >> 6) == word)
+		bits |= static_cast<uint64_t>(1) << (goal.x & 63);
+
+	return bits;
+}
+
+
+bool RDGNavigation::jumpRow(uint32_t x, uint32_t y, int dx, RDGPoint goal, uint32_t& out) const
+{
+	const uint32_t width = mLayout.getWidth();
+	const uint32_t stride = mLayout.getStride();
+
+	uint32_t position;
+	uint64_t bits;
+
+	// Find the first wall or side opening, a whole word of tiles at a time
+	if (dx > 0)
+	{
+		const uint32_t from = x + 1;
+
+		if (from >= width)
+			return false;
+
+		uint32_t word = from >> 6;
+		bits = stopBits(y, word, goal) & (~static_cast<uint64_t>(0) << (from & 63));
+
+		while (bits == 0)
+		{
+			if (++word == stride)
+				return false;
+
+			bits = stopBits(y, word, goal);
+		}
+
+		position = word * 64 + RDGLayout::lowestBit(bits);
+	}
+	else
+	{
+		if (x == 0)
+			return false;
+
+		const uint32_t from = x - 1;
+
+		uint32_t word = from >> 6;
+		bits = stopBits(y, word, goal);
+
+		if ((from & 63) != 63)
+			bits &= (static_cast<uint64_t>(1) << ((from & 63) + 1)) - 1;
+
+		while (bits == 0)
+		{
+			if (word == 0)
+				return false;
+
+			bits = stopBits(y, --word, goal);
+		}
+
+		position = word * 64 + RDGLayout::highestBit(bits);
+	}
+
+	// Hitting a wall first means a dead end
+	if (position >= width || mLayout.isWall(position, y))
+		return false;
+
+	out = position;
+
+	return true;
+}
+
+
+bool RDGNavigation::jumpColumn(uint32_t x, uint32_t y, int dy, RDGPoint goal, uint32_t& out) const
+{
+	const uint32_t width = mLayout.getWidth();
+	const uint32_t height = mLayout.getHeight();
+
+	while (true)
+	{
+		if (dy > 0 ? y + 1 >= height : y == 0)
+			return false;
+
+		y += dy;
+
+		if (mLayout.isWall(x, y))
+			return false;
+
+		if ((x == goal.x && y == goal.y) ||
+			(x > 0 && !mLayout.isWall(x - 1, y)) ||
+			(x + 1 < width && !mLayout.isWall(x + 1, y)))
+			break;
+	}
+
+	out = y;
+
+	return true;
+}
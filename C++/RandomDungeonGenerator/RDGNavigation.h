@@ -0,0 +1,221 @@
+#pragma once
+
+//
+//	RDGNavigation.h by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include "RDGLayout.h"
+
+/**
+ *	One path request for RDGNavigation::findPaths()
+ */
+struct RDGPathQuery
+{
+	RDGPoint start;
+	RDGPoint goal;
+
+	/**
+	 *	Receives the length of the path in tiles, or RDGNavigation::NO_PATH
+	 */
+	unsigned int length;
+
+	/**
+	 *	Receives the waypoints of the path
+	 */
+	vector<RDGPoint> path;
+};
+
+
+/**
+ *	Distance from every floor tile to one target tile, found by a breadth-first
+	search.  Walking to any neighbour with a smaller distance leads to the
+	target along a shortest path, so the field doubles as a flow field.
+
+ *	Takes four bytes per tile, so is meant for a handful of key locations
+	(exits, treasure, the player) that many agents head towards.
+ */
+class RDGDistanceField
+{
+public:
+	RDGDistanceField();
+
+	/**
+	 *	Fill in the distances to a target tile
+
+	 *	@param layout : Layout to search
+	 *	@param target : Tile the distances are measured to
+	 */
+	void build(const RDGLayout& layout, RDGPoint target);
+
+	/**
+	 *	@return the distance from a tile to the target, or RDGNavigation::NO_PATH
+			if the target cannot be reached from it
+	 */
+	unsigned int getDistance(unsigned int x, unsigned int y) const
+	{
+		return mDistances[static_cast<size_t>(y) * mWidth + x];
+	}
+
+	/**
+	 *	Move one tile towards the target
+
+	 *	@param point : Tile to move from.  Receives the next tile on the way.
+
+	 *	@return false if the point is already on the target, or cannot reach it
+	 */
+	bool step(RDGPoint& point) const;
+
+	RDGPoint getTarget() const { return mTarget; }
+
+	size_t getMemoryUsage() const { return mDistances.capacity() * sizeof(uint32_t); }
+
+protected:
+	unsigned int mWidth;
+	unsigned int mHeight;
+	RDGPoint mTarget;
+
+	vector<uint32_t> mDistances;
+};
+
+
+/**
+ *	Path finding over the floor tiles of an RDGLayout, moving between the four
+	neighbouring tiles.
+
+ *	Paths are found with A*, optionally using jump point search: the search
+	runs straight along corridors without stopping, and only adds tiles where a
+	side passage opens up.  Corridors which end without a branch are dead ends,
+	and are dropped without adding anything.  In a maze this leaves just the
+	junctions in the open list.  Rows are scanned 64 tiles at a time using the
+	layout's packed wall bits.
+
+ *	Paths are returned as waypoints, with each waypoint in a straight line
+	from the one before.
+
+ *	The navigation only reads the layout, so any number of threads can search
+	at once, as long as each has its own Workspace.
+ */
+class RDGNavigation
+{
+public:
+	/**
+	 *	Returned in place of a length when there is no path
+	 */
+	static const unsigned int NO_PATH = ~0u;
+
+	/**
+	 *	Scratch memory for one search.  Reused between searches, so once it has
+		grown to fit, searching allocates nothing.  Only the tiles the search
+		reaches are stored, in a hash table cleared by bumping a stamp.
+	 */
+	class Workspace
+	{
+	public:
+		Workspace();
+
+	protected:
+		friend class RDGNavigation;
+
+		struct _entry
+		{
+			uint32_t tile;
+			uint32_t stamp;
+			uint32_t cost;
+			uint32_t parent;
+		};
+
+		struct _open
+		{
+			uint32_t score;
+			uint32_t cost;
+			uint32_t tile;
+		};
+
+		vector<_entry> mEntries;
+		vector<_open> mOpen;
+		uint32_t mMask;
+		uint32_t mCount;
+		uint32_t mStamp;
+
+		void begin();
+		_entry* find(uint32_t tile);
+		_entry* insert(uint32_t tile);
+		void grow();
+	};
+
+	/**
+	 *	@param layout : Layout to search.  Must outlive the navigation.
+	 */
+	RDGNavigation(const RDGLayout& layout);
+
+	/**
+	 *	Find a shortest path between two floor tiles.  If a distance field has
+		been built for the goal, the path is read from it instead of searching.
+
+	 *	@param start : Tile to start from
+	 *	@param goal : Tile to reach
+	 *	@param path : Receives the waypoints, from start to goal.  Cleared if
+			there is no path.
+	 *	@param workspace : Scratch memory for the search
+	 *	@param jump : Use jump point search.  If false, every tile is expanded
+			as in plain A*.
+
+	 *	@return the length of the path in tiles, or NO_PATH
+	 */
+	unsigned int findPath(RDGPoint start, RDGPoint goal, vector<RDGPoint>& path,
+		Workspace& workspace, bool jump = true) const;
+
+	/**
+	 *	Answer a batch of queries on a pool of worker threads
+
+	 *	@param queries : Queries to answer.  The results are written back into each.
+	 *	@param threads : Number of worker threads.  0 uses one per hardware thread.
+	 *	@param jump : Use jump point search
+	 */
+	void findPaths(vector<RDGPathQuery>& queries, unsigned int threads = 0, bool jump = true) const;
+
+	/**
+	 *	Build a distance field to a key location, which findPath() will then use
+		for any path ending there.  Must be rebuilt if the layout changes.
+
+	 *	@param target : Tile the field leads to
+
+	 *	@return the field, valid until the next call to addTarget() or clearTargets()
+	 */
+	const RDGDistanceField& addTarget(RDGPoint target);
+
+	/**
+	 *	Remove every distance field
+	 */
+	void clearTargets();
+
+	/**
+	 *	@return true if a tile is in the layout, and is a floor
+	 */
+	bool isFloor(RDGPoint point) const
+	{
+		return point.x < mLayout.getWidth() && point.y < mLayout.getHeight() &&
+			!mLayout.isWall(point.x, point.y);
+	}
+
+protected:
+	const RDGLayout& mLayout;
+
+	vector<RDGDistanceField> mFields;
+
+	unsigned int search(RDGPoint start, RDGPoint goal, vector<RDGPoint>& path,
+		Workspace& workspace, bool jump) const;
+	unsigned int follow(const RDGDistanceField& field, RDGPoint start,
+		vector<RDGPoint>& path) const;
+
+	bool jumpRow(uint32_t x, uint32_t y, int dx, RDGPoint goal, uint32_t& out) const;
+	bool jumpColumn(uint32_t x, uint32_t y, int dy, RDGPoint goal, uint32_t& out) const;
+	uint64_t stopBits(uint32_t y, uint32_t word, RDGPoint goal) const;
+};
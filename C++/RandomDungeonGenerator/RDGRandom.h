@@ -0,0 +1,132 @@
+#pragma once
+
+//
+//	RDGRandom.h by Chris Allen
+//
+//	This file is provided "as-is", for the sole purpose of a demonstration of my
+//	work.  It is not intended to be copied or used in an external or third-party
+//	project, and no support will be given for that use.
+//
+//	You may not use or copy this file, in whole or in part, to use for your own
+//	projects.  All rights reserved over this file.
+//
+
+#include <cstdint>
+
+/**
+ *	Random number source for the maze generators (xoshiro256**).
+
+ *	Unlike NovaRandom, each instance holds its own state and is always created
+	from an explicit seed, so the same seed gives the same dungeon.  split()
+	hands out generators whose sequences never overlap, one per worker thread
+	or tile, so work carved in parallel matches work carved in series.
+ */
+class RDGRandom
+{
+public:
+	/**
+	 *	Create a generator with a fixed seed.  The seed is expanded into the full
+		state with SplitMix64, so any value (including 0) is a good seed.
+	 */
+	explicit RDGRandom(uint64_t seed)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			seed += 0x9e3779b97f4a7c15ull;
+
+			uint64_t z = seed;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+			mState[i] = z ^ (z >> 31);
+		}
+	}
+
+	/**
+	 *	@return 64 random bits
+	 */
+	uint64_t next()
+	{
+		const uint64_t result = rotate(mState[1] * 5, 7) * 9;
+		const uint64_t t = mState[1] << 17;
+
+		mState[2] ^= mState[0];
+		mState[3] ^= mState[1];
+		mState[1] ^= mState[2];
+		mState[0] ^= mState[3];
+
+		mState[2] ^= t;
+		mState[3] = rotate(mState[3], 45);
+
+		return result;
+	}
+
+	/**
+	 *	@param bound : Upper bound of the result (exclusive)
+
+	 *	@return a random integer in the range [0, bound)
+	 */
+	unsigned int nextInt(unsigned int bound)
+	{
+		return static_cast<unsigned int>(((next() >> 32) * bound) >> 32);
+	}
+
+	/**
+	 *	@return true or false, with equal chance
+	 */
+	bool nextBool() { return (next() >> 63) != 0; }
+
+	/**
+	 *	Advance the generator by 2^128 calls to next()
+	 */
+	void jump()
+	{
+		static const uint64_t JUMP[] =
+		{
+			0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+			0xa9582618e03fc9aaull, 0x39abdc4529b1661cull
+		};
+
+		uint64_t s[4] = { 0, 0, 0, 0 };
+
+		for (uint64_t jump : JUMP)
+		{
+			for (int b = 0; b < 64; b++)
+			{
+				if (jump & (static_cast<uint64_t>(1) << b))
+				{
+					for (int i = 0; i < 4; i++)
+						s[i] ^= mState[i];
+				}
+
+				next();
+			}
+		}
+
+		for (int i = 0; i < 4; i++)
+			mState[i] = s[i];
+	}
+
+	/**
+	 *	Split off a new generator.  The new generator continues this one's
+		sequence, and this one jumps 2^128 calls ahead, so the two never overlap.
+
+	 *	@return the new generator
+	 */
+	RDGRandom split()
+	{
+		RDGRandom ret(*this);
+
+		jump();
+
+		return ret;
+	}
+
+protected:
+	uint64_t mState[4];
+
+	static uint64_t rotate(uint64_t x, int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+};
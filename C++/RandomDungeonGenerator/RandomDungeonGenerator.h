@@ -14,14 +14,17 @@
 #include <NovaWinGLApp.h>
 
 #include "RDGDungeon.h"
+#include "RDGChunkedDungeon.h"
 
 /**
  *	Application class for the RandomDungeonGenerator sample.
 
  *	RandomDungeonGenerator creates a single level, which contains
-	a randomly generated dungeon layout.
+	a randomly generated dungeon layout.  Run with -chunked [seed] to
+	stream an endless dungeon instead.
 
- *	Layout generation uses a depth-first search algorithym
+ *	Layout generation uses one of the RDGGenerator algorithms (a depth-first
+	search by default).  Run with -rooms or -caves for the other layout styles.
  */
 class RandomDungeonGenerator : public NovaWinGLApp
 {
@@ -30,4 +33,9 @@ public:
 
 	void run();
 	void onReshape(int width, int height);
+
+protected:
+	bool mChunked;
+	uint64_t mSeed;
+	RDGLayoutGenerator::Style mStyle;
 };
\ No newline at end of file
@@ -0,0 +1,35 @@
+/*
+ *		WSAllocations.h
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace WindSim
+{
+	/**
+	 *	Counts every allocation made through the global operator new, so the
+	 *	allocations made each frame can be measured.  Linking WSAllocations.cpp
+	 *	replaces the global operator new and delete.
+	 */
+	namespace Allocations
+	{
+		/**
+		 *	@return the number of allocations made since the program started
+		 */
+		uint64_t getCount();
+	}
+}
@@ -0,0 +1,134 @@
+/*
+ *		WSBenchmark.h
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace WindSim
+{
+	/**
+	 *	Scripted, repeatable run of a Scene, recording where each frame's CPU time
+	 *	goes.
+	 *
+	 *	Each frame steps by the same fixed time, and the emitter angle, wind power
+	 *	and camera angle follow a fixed timeline instead of the user's input, so
+	 *	every run does the same work.  Time is split between the stages of the
+	 *	frame by calling mark() as each one ends.
+	 */
+	class Benchmark
+	{
+	public:
+
+		/**
+		 *	Parts of a frame timed separately
+		 */
+		enum Stage
+		{
+			EMITTER,	// Moving the emitter and updating its settings
+			GRASS,		// Choosing each tile's level of detail
+			PHYSICS,	// Moving the particles, or stepping the CPU wind field
+			WIND,		// Drawing the wind into its render target
+			MAIN,		// Everything outside Scene::update, mostly the main render pass
+			STAGES
+		};
+
+		/**
+		 *	State of the scene at one frame of the timeline
+		 */
+		struct Frame
+		{
+			float emitterAngle;
+			float power;
+			float cameraAngle;
+		};
+
+		/**
+		 *	Fixed length of every frame, in milliseconds
+		 */
+		static const long STEP = 16;
+
+		/**
+		 *	@param frames : Number of frames to run
+		 *	@param report : Name of the file the report is written to
+		 */
+		Benchmark(unsigned int frames, const std::string& report);
+
+		/**
+		 *	@param frame : Frame of the timeline
+		 *
+		 *	@return the state of the scene at that frame
+		 */
+		static Frame getScript(unsigned int frame);
+
+		/**
+		 *	Start timing the next frame.  Time since the last frame ended counts
+		 *	towards the MAIN stage.
+		 */
+		void beginFrame();
+
+		/**
+		 *	Add the time since the last mark to a stage
+		 *
+		 *	@param stage : Stage which has just ended
+		 */
+		void mark(Stage stage);
+
+		/**
+		 *	Finish timing the current frame
+		 */
+		void endFrame();
+
+		/**
+		 *	@return the frame being timed
+		 */
+		unsigned int getFrame() const { return frame; }
+
+		/**
+		 *	@return true once every frame has been timed
+		 */
+		bool isFinished() const { return frame >= frames; }
+
+		/**
+		 *	Write the mean, percentiles and worst time of each stage, and of the
+		 *	whole frame, to the report file
+		 *
+		 *	@return true if the report was written
+		 */
+		bool writeReport() const;
+
+	protected:
+
+		typedef std::chrono::steady_clock Clock;
+
+		unsigned int frames;
+
+		unsigned int frame;
+
+		std::string report;
+
+		/**
+		 *	Milliseconds spent on each stage, per frame
+		 */
+		std::vector<float> times[STAGES];
+
+		Clock::time_point last;
+
+		bool started;
+	};
+}
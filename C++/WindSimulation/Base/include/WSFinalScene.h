@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "WSLaunch.h"
 #include "WSScene.h"
 
 namespace WindSim
@@ -29,6 +30,26 @@ namespace WindSim
 	 */
 	class FinalScene : public WindSim::Scene
 	{
+	public:
+		using WindSim::Scene::Scene;
+
+		/**
+		 *	Create the scene from the settings and start the App on it.  The App
+		 *	must already be open.  Shared by every platform's entry point.
+		 *
+		 *	Benchmarks only run on the desktop, where App::start() does not return
+		 *	until the App has closed.  On Android the settings' benchmarkFrames are
+		 *	ignored.
+		 *
+		 *	@param settings : Options for this run
+		 *	@param close : Asks the App to close, once a benchmark has finished.
+		 *	Without it the App stays open on the last frame.
+		 *
+		 *	@return the exit code for the program, once the App has closed: 1 if
+		 *	a benchmark's report could not be written, otherwise 0
+		 */
+		static int start(const LaunchSettings& settings, const std::function<void()>& close = nullptr);
+
 	protected:
 
 		/**
@@ -37,10 +58,11 @@ namespace WindSim
 		 *
 		 * @param x : X position of the blade
 		 * @param y : Y position of the blade
+		 * @param random : Random numbers for this blade only
 		 *
 		 * @return : A Transform matrix used to affect the blade
 		 */
-		Nova::Math::Transform setupBlade(unsigned int x, unsigned int y) override;
+		Nova::Math::Transform setupBlade(unsigned int x, unsigned int y, SeededRandom& random) override;
 
 		/**
 		 *	Setup the field of grass for the scene.
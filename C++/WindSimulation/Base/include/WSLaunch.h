@@ -0,0 +1,74 @@
+/*
+ *		WSLaunch.h
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace WindSim
+{
+	/**
+	 *	Options for a run of the simulation, shared by every platform
+	 */
+	struct LaunchSettings
+	{
+		/**
+		 *	Seed for the field and the wind.  A new one each run, unless one is
+		 *	asked for with -seed.
+		 */
+		uint64_t seed;
+
+		bool hashedGrass = false;
+		bool cpuWind = false;
+		bool cpuParticles = false;
+
+		/**
+		 *	Local gusts, vortices and turbulence blowing around the field, with
+		 *	cpuParticles
+		 */
+		unsigned int gusts = 24;
+
+		/**
+		 *	Frames to run as a benchmark, or 0 to run interactively
+		 */
+		unsigned int benchmarkFrames = 0;
+
+		/**
+		 *	File to write a Chrome trace to, in profiling builds, or empty
+		 */
+		std::string trace;
+
+		/**
+		 *	Default settings, with a random seed
+		 */
+		LaunchSettings();
+	};
+
+	/**
+	 *	Read the settings from the command line.  Does not depend on Nova, so
+	 *	headless tools read the same options.
+	 *
+	 *	-seed [n], -hashed, -cpuwind, -cpuparticles, -gusts [n],
+	 *	-benchmark [frames], -trace [file]
+	 *
+	 *	@param argc : Number of arguments
+	 *	@param argv : The arguments, including the program's name
+	 *
+	 *	@return the settings, with defaults for anything not given
+	 */
+	LaunchSettings parseArguments(int argc, char** argv);
+}
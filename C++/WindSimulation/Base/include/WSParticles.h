@@ -0,0 +1,246 @@
+/*
+ *		WSParticles.h
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "WSRandom.h"
+
+namespace WindSim
+{
+	/**
+	 *	Particle wind simulated on the CPU, for far more particles than Nova's
+	 *	emitter can take.
+	 *
+	 *	Particles are fired across the wind target from an emitter orbiting it, as
+	 *	the Scene's particle emitter does, and are coloured the same way: red and
+	 *	blue hold the direction they travel in, alpha the wind's power.  Instead of
+	 *	each particle being drawn, they are splatted into a grid, which the Scene
+	 *	draws with the same cell sprites as the CPU wind field.
+	 *
+	 *	Each property is kept in its own array (structure of arrays), so each pass
+	 *	over the particles is a straight loop over floats, which the compiler
+	 *	vectorises.  Live particles are packed at the front of the arrays; a dead
+	 *	one is swapped with the last live one, so spawning just takes the next free
+	 *	slot, and nothing is allocated after construction.
+	 *
+	 *	Alongside the main emitter, a number of local emitters (gust fronts,
+	 *	vortices and patches of turbulence) come and go around the field, so the
+	 *	wind varies from place to place.  Their particles share the pool, and are
+	 *	splatted into the same grid, so any number of them are drawn in the same
+	 *	pass.  They are updated together each step, on the thread which steps the
+	 *	particles.
+	 *
+	 *	Does not depend on Nova.
+	 */
+	class Particles
+	{
+	public:
+
+		/**
+		 *	Kinds of local emitter
+		 */
+		enum Kind
+		{
+			GUST,		// Front of stronger wind, sweeping across the field with the wind
+			VORTEX,		// Swirl around a point, drifting with the wind
+			TURBULENCE	// Patch of wind blowing in scattered directions
+		};
+
+		struct Settings
+		{
+			unsigned int maxParticles = 100000;
+
+			/**
+			 *	Range of each particle's life, in seconds
+			 */
+			float life[2] = { 3.0f, 5.0f };
+
+			/**
+			 *	Range of each particle's speed, in units of the wind target (which
+			 *	is 100 across) per second
+			 */
+			float speed[2] = { 30.0f, 40.0f };
+
+			/**
+			 *	Degrees either side of the wind's direction particles are fired at
+			 */
+			float coneAngle = 10.0f;
+
+			/**
+			 *	Width of the emitter, across the wind's direction
+			 */
+			float spread = 60.0f;
+
+			/**
+			 *	Cells either side of a particle's own which its colour spreads to, as the
+			 *	emitter's particles are drawn as large soft sprites
+			 */
+			unsigned int blur = 2;
+
+			/**
+			 *	Local emitters alive at once
+			 */
+			unsigned int emitters = 0;
+
+			/**
+			 *	Share of the pool the local emitters fire, from 0 to 1
+			 */
+			float emitterShare = 0.4f;
+		};
+
+		/**
+		 *	@param settings : Size and behaviour of the particles
+		 *	@param seed : Seed for the particles.  The same seed and steps always
+		 *	give the same particles.
+		 */
+		Particles(const Settings& settings, uint64_t seed);
+
+		/**
+		 *	Set the wind the particles are fired with
+		 *
+		 *	@param angle : Direction the wind comes from, in degrees, as the
+		 *	Scene's emitterAngle
+		 *	@param power : Strength of the wind, from 0 to 1
+		 */
+		void setWind(float angle, float power);
+
+		/**
+		 *	Fire new particles, move every particle, and remove any which have
+		 *	died or left the target
+		 *
+		 *	@param seconds : Length of the step
+		 */
+		void step(float seconds);
+
+		/**
+		 *	Splat the particles into a grid covering the wind target, in the
+		 *	format WindFinal.glsl reads
+		 *
+		 *	@param size : Width and height of the grid, in cells
+		 *	@param rgba : Receives four floats for each cell, row by row
+		 */
+		void splat(unsigned int size, float* rgba);
+
+		/**
+		 *	@return the number of live particles
+		 */
+		unsigned int getCount() const { return count; }
+
+	protected:
+
+		/**
+		 *	Distance of the emitter from the centre of the target, and of the
+		 *	edge beyond which particles are removed
+		 */
+		static const float EMITTER_DISTANCE;
+		static const float EDGE;
+
+		Settings settings;
+
+		/**
+		 *	Each particle's position, velocity, age and life, and colour
+		 */
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> vx;
+		std::vector<float> vy;
+		std::vector<float> age;
+		std::vector<float> life;
+		std::vector<float> red;
+		std::vector<float> blue;
+		std::vector<float> alpha;
+
+		unsigned int count;
+
+		/**
+		 *	Sums of the particles' colours in each cell, and their number, for
+		 *	splat().  Kept to save allocating them each time.
+		 */
+		std::vector<float> cells;
+		std::vector<float> blurred;
+
+		/**
+		 *	Each local emitter's kind, position, velocity, radius, age, life and
+		 *	firing rate, and the particles it still has to fire
+		 */
+		std::vector<Kind> emitterKind;
+		std::vector<float> emitterX;
+		std::vector<float> emitterY;
+		std::vector<float> emitterVX;
+		std::vector<float> emitterVY;
+		std::vector<float> emitterRadius;
+		std::vector<float> emitterAge;
+		std::vector<float> emitterLife;
+		std::vector<float> emitterRate;
+		std::vector<float> emitterPending;
+
+		/**
+		 *	Direction the wind blows towards, and its power
+		 */
+		float directionX;
+		float directionY;
+		float power;
+
+		/**
+		 *	Particles still to be fired, from the fraction of one left each step
+		 */
+		float pending;
+
+		SeededRandom random;
+
+		/**
+		 *	Fire one particle from the main emitter
+		 */
+		void spawn();
+
+		/**
+		 *	Fire one particle from a local emitter
+		 *
+		 *	@param emitter : Index of the emitter
+		 */
+		void spawnFrom(unsigned int emitter);
+
+		/**
+		 *	Put a particle into the next free slot
+		 *
+		 *	@param px, py : Position
+		 *	@param dx, dy : Direction of travel, normalised, which also sets its colour
+		 *	@param speed : Speed along that direction
+		 *	@param lifetime : Seconds until it dies
+		 *	@param strength : Its alpha, the wind's power where it passes
+		 */
+		void add(float px, float py, float dx, float dy, float speed, float lifetime, float strength);
+
+		/**
+		 *	Move and age every local emitter, replacing any which have died
+		 */
+		void updateEmitters(float seconds);
+
+		/**
+		 *	Start a new local emitter, of a random kind, in place of an old one
+		 *
+		 *	@param emitter : Index of the emitter
+		 */
+		void startEmitter(unsigned int emitter);
+
+		/**
+		 *	Replace the particle at index with the last live one
+		 */
+		void remove(unsigned int index);
+	};
+}
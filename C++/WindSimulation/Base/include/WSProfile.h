@@ -0,0 +1,207 @@
+/*
+ *		WSProfile.h
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ *	Profiling is only compiled in when WS_PROFILE is defined.  Without it the
+ *	macros below expand to nothing, so the timers cost nothing in a normal build.
+ *
+ *	Names must be string literals, or otherwise outlive the profiler, as only
+ *	the pointer is kept.
+ */
+#if defined(WS_PROFILE)
+
+#define WS_PROFILE_JOIN2(a, b) a##b
+#define WS_PROFILE_JOIN(a, b) WS_PROFILE_JOIN2(a, b)
+
+/**
+ *	Time from here to the end of the enclosing scope
+ */
+#define WS_PROFILE_SCOPE(name) WindSim::Profile::Scope WS_PROFILE_JOIN(profileScope, __LINE__)(name)
+
+/**
+ *	Record the value of a counter at this point in time
+ */
+#define WS_PROFILE_COUNT(name, value) WindSim::Profile::count(name, static_cast<int64_t>(value))
+
+#else
+
+#define WS_PROFILE_SCOPE(name) ((void)0)
+#define WS_PROFILE_COUNT(name, value) ((void)0)
+
+#endif
+
+namespace WindSim
+{
+	/**
+	 *	Scoped timers and counters, for seeing where each frame's time goes.
+	 *
+	 *	Any thread can record events.  They go into a fixed size lock-free ring,
+	 *	which one thread (the Scene's) drains each frame, for the overlay and for
+	 *	writing out as a Chrome trace (chrome://tracing, or ui.perfetto.dev).  If
+	 *	the ring fills before it is drained, new events are dropped and counted.
+	 */
+	namespace Profile
+	{
+		/**
+		 *	One timed scope, or one reading of a counter
+		 */
+		struct Event
+		{
+			const char* name;
+
+			/**
+			 *	Microseconds since the profiler started
+			 */
+			uint64_t start;
+
+			/**
+			 *	Length of a timed scope, in microseconds.  0 for counters.
+			 */
+			uint32_t duration;
+
+			/**
+			 *	Small number identifying the thread which recorded the event
+			 */
+			uint32_t thread;
+
+			/**
+			 *	Value of a counter
+			 */
+			int64_t value;
+
+			bool counter;
+		};
+
+		/**
+		 *	@return microseconds since the profiler started
+		 */
+		uint64_t now();
+
+		/**
+		 *	Record a timed scope
+		 *
+		 *	@param name : Name of the scope
+		 *	@param start : Time the scope started, from now()
+		 *	@param end : Time the scope ended, from now()
+		 */
+		void record(const char* name, uint64_t start, uint64_t end);
+
+		/**
+		 *	Record the value of a counter
+		 *
+		 *	@param name : Name of the counter
+		 *	@param value : Its value
+		 */
+		void count(const char* name, int64_t value);
+
+		/**
+		 *	Take every event recorded so far out of the ring.  Only one thread
+		 *	may drain the ring.
+		 *
+		 *	@param events : The events are added to the end of this
+		 *
+		 *	@return the number of events added
+		 */
+		size_t drain(std::vector<Event>& events);
+
+		/**
+		 *	@return the number of events dropped because the ring was full
+		 */
+		uint64_t getDropped();
+
+		/**
+		 *	Write events out in the Chrome trace event format
+		 *
+		 *	@param file : Name of the file to write
+		 *	@param events : Events to write, as drained
+		 *
+		 *	@return true if the file was written
+		 */
+		bool writeTrace(const std::string& file, const std::vector<Event>& events);
+
+		/**
+		 *	Times its own lifetime.  Use through WS_PROFILE_SCOPE.
+		 */
+		class Scope
+		{
+		public:
+
+			explicit Scope(const char* name) : name(name), start(now()) {}
+
+			~Scope() { record(name, start, now()); }
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+		protected:
+
+			const char* name;
+			uint64_t start;
+		};
+
+		/**
+		 *	Totals of each scope and counter over a number of frames, for an
+		 *	on-screen overlay
+		 */
+		class Summary
+		{
+		public:
+
+			/**
+			 *	Add drained events to the totals
+			 */
+			void add(const std::vector<Event>& events);
+
+			/**
+			 *	Count another frame
+			 */
+			void endFrame() { frames++; }
+
+			unsigned int getFrames() const { return frames; }
+
+			/**
+			 *	@return one line per scope and counter, with the mean time per
+			 *	frame of each scope and the mean value of each counter
+			 */
+			std::string format() const;
+
+			/**
+			 *	Clear the totals and the frame count
+			 */
+			void reset();
+
+		protected:
+
+			struct Total
+			{
+				const char* name;
+				double sum;
+				uint64_t samples;
+				bool counter;
+			};
+
+			std::vector<Total> totals;
+
+			unsigned int frames = 0;
+		};
+	}
+}
@@ -0,0 +1,104 @@
+/*
+ *		WSRandom.h
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace WindSim
+{
+	/**
+	 *	Seeded random number source (SplitMix64).
+	 *
+	 *	Unlike Nova::Math::Random, each instance holds its own state.  The state is
+	 *	just a counter, so a generator can jump to any point in its sequence, and
+	 *	split() can hand out a separate stream per blade of grass.  Blades set up in
+	 *	any order, or on any thread, get the same numbers.
+	 */
+	class SeededRandom
+	{
+	public:
+
+		/**
+		 *	@param seed : Seed of the sequence.  The same seed gives the same numbers.
+		 */
+		explicit SeededRandom(uint64_t seed) : state(seed) {}
+
+		/**
+		 *	@return 64 random bits
+		 */
+		uint64_t next()
+		{
+			state += GOLDEN;
+
+			return mix(state);
+		}
+
+		/**
+		 *	@param min : Lowest value to return
+		 *	@param max : Highest value to return
+		 *
+		 *	@return a random float in the range [min, max)
+		 */
+		float nextFloat(float min, float max)
+		{
+			// Top 24 bits fill the float's mantissa exactly
+			const float unit = static_cast<float>(next() >> 40) * (1.0f / 16777216.0f);
+
+			return min + (max - min) * unit;
+		}
+
+		/**
+		 *	Skip ahead in the sequence, as if next() had been called count times
+		 *
+		 *	@param count : Number of values to skip
+		 */
+		void jump(uint64_t count)
+		{
+			state += GOLDEN * count;
+		}
+
+		/**
+		 *	Create a separate generator for one stream of this sequence, e.g. one blade
+		 *	of grass.  Does not change this generator.
+		 *
+		 *	@param stream : Index of the stream
+		 *
+		 *	@return the new generator
+		 */
+		SeededRandom split(uint64_t stream) const
+		{
+			return SeededRandom(mix(state ^ mix(stream + GOLDEN)));
+		}
+
+	protected:
+
+		static const uint64_t GOLDEN = 0x9e3779b97f4a7c15ull;
+
+		/**
+		 *	Current position in the sequence
+		 */
+		uint64_t state;
+
+		static uint64_t mix(uint64_t z)
+		{
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+			return z ^ (z >> 31);
+		}
+	};
+}
@@ -24,6 +24,16 @@
 #include <NovaApp.h>
 #include <NovaProp.h>
 
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "WSBenchmark.h"
+#include "WSProfile.h"
+#include "WSRandom.h"
+#include "WSSimulation.h"
+#include "WSWindField.h"
+
 namespace WindSim
 {
 	/**
@@ -35,7 +45,42 @@ namespace WindSim
 	class Scene : public Nova::Scene
 	{
 	public:
-		Scene();
+
+		/**
+		 *	Width and depth of each tile of the field of grass, in blades
+		 */
+		static const unsigned int GRASS_TILE = 25;
+
+		/**
+		 *	Levels of detail for each tile of grass.  The nearest has 5 segments to
+		 *	each blade, then 2, then 1.
+		 */
+		static const unsigned int GRASS_LODS = 3;
+
+		/**
+		 *	Width and height of the CPU wind field, in cells
+		 */
+		static const unsigned int WIND_CELLS = 20;
+
+		/**
+		 *	Number of times a second the wind is drawn, whatever the frame rate
+		 */
+		static const unsigned int WIND_RATE = 30;
+
+		/**
+		 *	@param seed : Seed for the field of grass.  The same seed always grows the
+		 *	same field.
+		 *	@param hashedGrass : Shape the blades in the vertex shader, rather than
+		 *	on the CPU.  See hashedGrass.
+		 *	@param cpuWind : Simulate the wind on the CPU, rather than with the
+		 *	particle effect.  See windField.
+		 *	@param cpuParticles : Simulate the particles on the CPU, rather than
+		 *	with Nova's emitter.  See particles.
+		 *	@param gusts : Local gusts, vortices and turbulence blowing around the
+		 *	field at once, with cpuParticles
+		 */
+		Scene(uint64_t seed = 0, bool hashedGrass = false, bool cpuWind = false, bool cpuParticles = false,
+			unsigned int gusts = 0);
 
 		/**
 		 * Update the scene and its objects
@@ -49,6 +94,29 @@ namespace WindSim
 		 */
 		void release() override;
 
+		/**
+		 *	Run the scene as a benchmark rather than interactively.  The wind and
+		 *	camera follow Benchmark's scripted timeline with a fixed timestep.  Once
+		 *	the report has been written the scene stops updating, and calls
+		 *	finished so the platform can close the App through its normal shutdown.
+		 *
+		 *	@param frames : Number of frames to run
+		 *	@param report : Name of the file to write the timings to
+		 *	@param finished : Called once, with the program's exit code: 0 if the
+		 *	report was written, or 1 if not
+		 */
+		void setBenchmark(unsigned int frames, const std::string& report, const std::function<void(int)>& finished);
+
+#if defined(WS_PROFILE)
+		/**
+		 *	Keep every profiling event, and write them out as a Chrome trace when
+		 *	the scene is released or the benchmark finishes
+		 *
+		 *	@param file : Name of the file to write the trace to
+		 */
+		void setTrace(const std::string& file);
+#endif
+
 		/**
 		 *	Handle a window resize event
 		 *
@@ -79,10 +147,11 @@ namespace WindSim
 		float vCamera;
 
 		/**
-		 * Speed and direction of emitter movement in the scene.
+		 * Speed and direction the user is turning the emitter, in degrees per
+		 * simulation step, or 0 to let it turn on its own.
 		 *
-		 * If movement is required, the emitter orbits around the center of the world,
-		 * giving the appearance of the wind changing direction
+		 * The emitter orbits around the center of the world, giving the appearance
+		 * of the wind changing direction
 		 */
 		float vEmitter;
 
@@ -90,9 +159,29 @@ namespace WindSim
 		 * Render target for the wind effect.  The effect renders to texture, rather
 		 * than into the main scene.  This gives us a texture we can sample when displacing
 		 * our grass.
+		 *
+		 * This is the target the next update of the wind is drawn into.  The grass
+		 * samples windFront, so is never reading the texture being drawn.
 		 */
 		Nova::SubStage_p wind;
 
+		/**
+		 * Render target holding the last update of the wind, sampled by the grass
+		 */
+		Nova::SubStage_p windFront;
+
+		/**
+		 * Milliseconds towards the next time the wind is drawn
+		 */
+		long windElapsed;
+
+		/**
+		 * Simulation::State::windStep the wind was last drawn from, and whether
+		 * that drawing is still waiting to be swapped in for the grass
+		 */
+		uint64_t windStep;
+		bool windDrawn;
+
 		/**
 		 * Widget which shows the current state of the offscreen render target.
 		 */
@@ -108,6 +197,18 @@ namespace WindSim
 		 */
 		std::shared_ptr<Nova::SimpleActor> windOverlay;
 
+		/**
+		 * Settings the wind emitter was set up with.  Kept so the colours can be
+		 * changed without copying the settings out of the emitter each time.
+		 */
+		Nova::EmitterProp::Settings windSettings;
+
+		/**
+		 * Colour ranges the emitter was last set up with, as 8 bits each of the
+		 * two direction channels and the two alpha values
+		 */
+		uint32_t emitterColour;
+
 		/**
 		 * Particle emitter for the wind effect.  Particles emitted from a ParticleGun
 		 * are unaffected by changes in their parent emitter's movements after they are
@@ -135,6 +236,68 @@ namespace WindSim
 		 */
 		Nova::TextWidget textPower;
 
+		/**
+		 *	Text widget showing how long the field of grass took to build
+		 */
+		Nova::TextWidget textGrass;
+
+		/**
+		 *	Text widget showing the average time spent on the wind each frame
+		 */
+		Nova::TextWidget textWind;
+
+		/**
+		 *	Text widget showing how evenly frames arrive, and how long input takes
+		 *	to show
+		 */
+		Nova::TextWidget textPacing;
+
+#if defined(WS_PROFILE)
+		/**
+		 *	Overlay showing the mean time of each profiled scope per frame
+		 */
+		Nova::TextWidget textProfile;
+
+		/**
+		 *	Events drained from the profiler this frame, and their totals over the
+		 *	last few frames
+		 */
+		std::vector<Profile::Event> profileEvents;
+		Profile::Summary profileSummary;
+
+		/**
+		 *	Every event so far, when writing a trace
+		 */
+		std::vector<Profile::Event> trace;
+		std::string traceFile;
+
+		/**
+		 *	Drain the profiler into the overlay and the trace
+		 */
+		void updateProfile();
+
+		/**
+		 *	Write out the trace, if one was asked for
+		 */
+		void writeTrace();
+#endif
+
+		/**
+		 *	Time spent on the wind over the last few frames, and the number of frames
+		 */
+		float windMillis;
+		unsigned int windFrames;
+
+		/**
+		 *	Allocations made by update() over the last few frames
+		 */
+		uint64_t windAllocations;
+
+		/**
+		 *	Lower end of the wind power range textPower is showing, as a percentage
+		 */
+		int shownPower;
+
 		/**
 		 * Current wind power
 		 */
@@ -169,6 +332,143 @@ namespace WindSim
 		 */
 		std::string shaderFile;
 
+		/**
+		 *	Size and spacing of the field of grass, in blades and in tiles
+		 */
+		struct GrassLayout
+		{
+			unsigned int bladesX;
+			unsigned int bladesY;
+			unsigned int tilesX;
+			unsigned int tilesY;
+			float spacingX;
+			float spacingY;
+			float cull;
+		};
+
+		/**
+		 *	Buffers one mesh of the field is built into.  Kept between builds of the
+		 *	field, so only grow when a bigger field is built, and are freed by
+		 *	release().
+		 */
+		struct GrassScratch
+		{
+			std::vector<float> vertices;
+			std::vector<float> uvs;
+			std::vector<unsigned int> indices;
+
+			/**
+			 *	Number of blades in the mesh, after culling
+			 */
+			unsigned int blades;
+		};
+
+		/**
+		 *	One square tile of the field, drawn with one of its meshes depending on
+		 *	how far it is from the camera
+		 */
+		struct GrassTile
+		{
+			std::shared_ptr<Nova::SimpleActor> actor;
+			Nova::ModelProp* prop;
+			Nova::Model_p lods[GRASS_LODS];
+
+			float centreX;
+			float centreZ;
+
+			/**
+			 *	Level of detail the tile is drawn with
+			 */
+			unsigned int lod;
+		};
+
+		GrassLayout grassLayout;
+
+		/**
+		 *	Tiles of the field, row by row
+		 */
+		std::vector<GrassTile> grassTiles;
+
+		/**
+		 *	Buffers of each tile's meshes, GRASS_LODS per tile
+		 */
+		std::vector<GrassScratch> grassScratch;
+
+		/**
+		 * Seed used to grow the field of grass
+		 */
+		uint64_t fieldSeed;
+
+		/**
+		 * Flag to state if the blades are shaped in the vertex shader.
+		 *
+		 * When set, createGrass() skips setupBlade() and the per-vertex matrix
+		 * multiply, and writes each blade's base position plus a random key.  The
+		 * shader (WindHashed.glsl) hashes the key into the blade's size, rotation
+		 * and offset.
+		 */
+		bool hashedGrass;
+
+		/**
+		 * Flag to state if the wind is simulated on the CPU.
+		 *
+		 * When set, windField replaces the particle effect.  The simulation steps
+		 * the field on its thread, and the field's cells are drawn into the wind
+		 * render target as soft sprites, coloured the same way as the particles.
+		 */
+		bool cpuWind;
+
+		/**
+		 *	CPU wind simulation, when cpuWind is set
+		 */
+		std::unique_ptr<WindField> windField;
+
+		/**
+		 * Flag to state if the particles are simulated on the CPU.
+		 *
+		 * When set, and cpuWind is not, particles replaces Nova's emitter, with a
+		 * hundred times as many particles.  They are splatted into a grid on the
+		 * simulation's thread, and drawn with the same sprites as windField.
+		 */
+		bool cpuParticles;
+
+		/**
+		 *	Local emitters added to particles, as Particles::Settings::emitters
+		 */
+		unsigned int gusts;
+
+		/**
+		 *	CPU particles, when cpuParticles is set
+		 */
+		std::unique_ptr<Particles> particles;
+
+		/**
+		 *	Scripted run and timings, when running as a benchmark
+		 */
+		std::unique_ptr<Benchmark> benchmark;
+
+		/**
+		 *	Called when the benchmark ends, and set once it has
+		 */
+		std::function<void(int)> benchmarkFinished;
+		bool benchmarkDone;
+
+		/**
+		 *	Wind direction, power and field, stepped on their own thread.
+		 *	emitterAngle and power hold the step being shown.
+		 */
+		std::unique_ptr<Simulation> simulation;
+
+		/**
+		 *	Time the frame being drawn is shown, from the host's frame times
+		 */
+		double displayTime;
+
+		/**
+		 *	Sprites drawing each cell of windField, row by row
+		 */
+		std::vector<std::shared_ptr<Nova::SimpleActor>> windCells;
+
 		/**
 		 *	Prepare the Scene's content, loading resources and creating objects
 		 *
@@ -191,6 +491,10 @@ namespace WindSim
 		 * patchiness of the field, by changing the number of blades in each direction,
 		 * the size of the field, and the amount of grass culled.
 		 *
+		 * The field is split into tiles of GRASS_TILE by GRASS_TILE blades, each with
+		 * GRASS_LODS meshes.  The meshes are built in parallel, one thread per core,
+		 * and the build rate is shown in the UI.
+		 *
 		 * @param bladesX : Number of blades of grass in the X axis
 		 * @param bladesY : Number of blades of grass in the Y axis
 		 * @param width : Width of the field
@@ -199,6 +503,22 @@ namespace WindSim
 		 */
 		void createGrass(unsigned int bladesX, unsigned int bladesY, unsigned int width, unsigned int height, float cull = 0.0f);
 
+		/**
+		 * Build one mesh of one tile of the field of grass.  Safe to call from
+		 * several threads at once, for different meshes.
+		 *
+		 * @param mesh : Receives the mesh
+		 * @param tile : Index of the tile, row by row
+		 * @param segments : Number of segments in each blade
+		 */
+		void buildGrassMesh(GrassScratch& mesh, unsigned int tile, unsigned int segments);
+
+		/**
+		 * Choose the level of detail of each tile of grass, from its distance to
+		 * the camera and whether it is in view
+		 */
+		void updateGrass();
+
 		/**
 		 * Setup and create the field of grass.  Must be implemented by subclasses.
 		 *
@@ -213,20 +533,51 @@ namespace WindSim
 		 * This may be implemented in a separate file to the other functions,
 		 * based on the platform, and based on requirements.
 		 *
+		 * Nova on Android does not pass input to the Scene, so update() drains
+		 * the Context's events there each frame, and hands each one to this.
+		 *
 		 * @param event : The latest Input Event
+		 *
+		 * @return true if the event was used
+		 */
+#if defined(NOVA_ANDROID)
+		bool handleInput(const Nova::Input_p& event);
+
+		/**
+		 * Steer the wind with the newest joystick position read this frame, if
+		 * any.  However many events arrive, the angle and power are worked out
+		 * once.
+		 */
+		void applyInput();
+
+		/**
+		 * Most events read from the Context each frame
+		 */
+		static const unsigned int MAX_EVENTS = 64;
+
+		/**
+		 * Newest joystick position this frame, and whether there is one
 		 */
+		Nova::Math::Vector joystick;
+		bool joystickMoved;
+#else
 		virtual bool handleInput(const Nova::Input_p& event) override;
+#endif
 
 		/**
 		 * Setup a single blade of grass, affecting the size, position and rotation.
 		 *
 		 * This prevents the field from appearing uniform.
 		 *
+		 * Called from several threads at once while the field is built, so must only
+		 * use its arguments.
+		 *
 		 * @param x : X position of the blade in the field
 		 * @param y : Y position of the blade in the field
+		 * @param random : Random numbers for this blade only
 		 * @return A transform matrix to apply to the Blade, which changes its height and rotation
 		 */
-		virtual Nova::Math::Transform setupBlade(unsigned int x, unsigned int y) = 0;
+		virtual Nova::Math::Transform setupBlade(unsigned int x, unsigned int y, SeededRandom& random) = 0;
 
 		/**
 		 * Setup the wind particle effect
@@ -251,11 +602,30 @@ namespace WindSim
 		void setupCamera(Nova::MainStage_p& mainStage);
 
 		/**
-		 * Update the wind emitter's position, direction and effect
+		 * Draw the next update of the wind into the back target: the simulation's
+		 * colours, with the CPU wind or particles, or else Nova's emitter
 		 *
-		 *	@param seconds : Number of seconds since the last update
+		 * @param state : Newest state of the simulation
+		 */
+		void drawWind(const Simulation::State& state);
+
+		/**
+		 * Swap the wind render targets, before the next update of the wind is
+		 * drawn, and point the grass at the one drawn last
+		 */
+		void swapWind();
+
+		/**
+		 * Update the wind power text, if the range it shows has changed
+		 */
+		void updatePowerText();
+
+		/**
+		 * Move the wind emitter and arrow to emitterAngle, and set the effect's
+		 * colours from it and power.  The emitter's settings are only set up
+		 * again if its colours have changed.
 		 */
-		void updateEmitter(float seconds);
+		void updateEmitter();
 	};
 
 }
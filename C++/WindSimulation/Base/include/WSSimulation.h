@@ -0,0 +1,338 @@
+/*
+ *		WSSimulation.h
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "WSParticles.h"
+#include "WSWindField.h"
+
+namespace WindSim
+{
+	/**
+	 *	Hands the latest of a stream of values from one thread to another without
+	 *	locking.  The writer fills back() and publishes it; the reader takes the
+	 *	newest published value with acquire(), and keeps reading it from front()
+	 *	until it acquires again.  Neither side ever waits for the other.
+	 */
+	template <typename T>
+	class TripleBuffer
+	{
+	public:
+
+		/**
+		 *	@return the buffer the writer fills next
+		 */
+		T& back() { return buffers[backIndex]; }
+
+		/**
+		 *	Make the back buffer the newest value, replacing any the reader has
+		 *	not taken yet
+		 */
+		void publish()
+		{
+			backIndex = middle.exchange(backIndex | FRESH, std::memory_order_acq_rel) & INDEX;
+		}
+
+		/**
+		 *	Take the newest value, if one has been published since the last call
+		 *
+		 *	@return true if front() has changed
+		 */
+		bool acquire()
+		{
+			if ((middle.load(std::memory_order_relaxed) & FRESH) == 0)
+				return false;
+
+			frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & INDEX;
+
+			return true;
+		}
+
+		/**
+		 *	@return the value the reader last acquired
+		 */
+		const T& front() const { return buffers[frontIndex]; }
+
+	protected:
+
+		static const unsigned int INDEX = 3;
+		static const unsigned int FRESH = 4;
+
+		T buffers[3];
+
+		/**
+		 *	Buffer between the two sides, and whether it holds a value the reader
+		 *	has not seen
+		 */
+		std::atomic<unsigned int> middle{ 1 };
+
+		unsigned int backIndex = 0;
+		unsigned int frontIndex = 2;
+	};
+
+
+	/**
+	 *	The wind's direction and power, and the CPU wind field or particles,
+	 *	stepped at a fixed rate on their own thread.
+	 *
+	 *	Each frame the render thread says when the frame will be shown, with
+	 *	frame().  The simulation keeps one step ahead of that time, and hands each
+	 *	step to the render thread through a triple buffer, so neither thread waits
+	 *	for the other.  Input can be set from any thread.
+	 *
+	 *	Does not depend on Nova, so it can be run without a window.
+	 */
+	class Simulation
+	{
+	public:
+
+		typedef std::chrono::steady_clock Clock;
+
+		/**
+		 *	Steps per second
+		 */
+		static const unsigned int RATE = 60;
+
+		/**
+		 *	Degrees the emitter turns each step while it is not being steered
+		 */
+		static const float AUTO_TURN;
+
+		/**
+		 *	State of one step, as handed to the render thread
+		 */
+		struct State
+		{
+			/**
+			 *	Number of steps taken
+			 */
+			uint64_t step = 0;
+
+			float emitterAngle = 0.0f;
+			float power = 0.0f;
+
+			/**
+			 *	Colour of each cell of the wind field or particles, row by row, four
+			 *	floats a cell.  Empty without either.
+			 */
+			std::vector<float> wind;
+
+			/**
+			 *	Number of times the field has stepped, so the wind is only drawn
+			 *	again when it has changed
+			 */
+			uint64_t windStep = 0;
+
+			/**
+			 *	Live particles, and the time taken to step them, in ms
+			 */
+			unsigned int particles = 0;
+			float particleMillis = 0.0f;
+
+			/**
+			 *	Newest input this step has applied, and when the oldest of the
+			 *	inputs merged into it arrived
+			 */
+			uint64_t input = 0;
+			Clock::time_point inputTime;
+		};
+
+		/**
+		 *	How evenly frames have arrived, and how long input took to be shown,
+		 *	since the last resetPacing()
+		 */
+		struct Pacing
+		{
+			unsigned int frames = 0;
+
+			/**
+			 *	Mean and standard deviation of the time between frames, in ms
+			 */
+			float interval = 0.0f;
+			float jitter = 0.0f;
+
+			/**
+			 *	Mean and worst time from input arriving to the first frame showing
+			 *	it, in ms
+			 */
+			float latency = 0.0f;
+			float maxLatency = 0.0f;
+		};
+
+		/**
+		 *	@param emitterAngle : Starting direction of the wind, in degrees
+		 *	@param power : Starting power of the wind
+		 *	@param field : CPU wind field to step, or nullptr.  Must outlive the
+		 *	simulation.
+		 *	@param particles : CPU particles to step when there is no field, or
+		 *	nullptr.  Must outlive the simulation.
+		 *	@param cells : Width and height of the grid the particles are splatted
+		 *	into
+		 *	@param fieldRate : Steps per second of the field, and splats per second
+		 *	of the particles
+		 *	@param threaded : false to step on the render thread, inside frame(),
+		 *	so every run takes exactly the same steps
+		 */
+		Simulation(float emitterAngle, float power, WindField* field, Particles* particles,
+			unsigned int cells, unsigned int fieldRate, bool threaded);
+
+		/**
+		 *	Stops the simulation thread
+		 */
+		~Simulation();
+
+		/**
+		 *	Set how the user is steering the wind.  Can be called from any thread.
+		 *
+		 *	@param turn : Degrees to turn the emitter each step, or 0 to let it turn
+		 *	on its own
+		 *	@param dPower : 1 to raise the wind's power, -1 to lower it, 0 to hold it
+		 */
+		void setInput(float turn, float dPower);
+
+		/**
+		 *	Point the wind in a direction at a power, as with a joystick.  Holds
+		 *	until the next call, or until setInput() is called.  Can be called
+		 *	from any thread.
+		 *
+		 *	Any number of calls between two steps are merged, and only the last is
+		 *	applied.
+		 *
+		 *	@param emitterAngle : Direction of the wind, in degrees
+		 *	@param power : Power of the wind, clamped to the range the keys allow
+		 */
+		void setSteering(float emitterAngle, float power);
+
+		/**
+		 *	Fix the wind's direction and power from the next step on, in place of
+		 *	the input, for scripted runs
+		 */
+		void setScript(float emitterAngle, float power);
+
+		/**
+		 *	Tell the simulation when the next frame will be shown.  Called by the
+		 *	render thread once a frame.
+		 *
+		 *	@param seconds : Time the frame will be shown, from the host's frame
+		 *	timestamps
+		 */
+		void frame(double seconds);
+
+		/**
+		 *	Take the newest step, if there is one the render thread has not seen
+		 *
+		 *	@return true if getState() has changed
+		 */
+		bool acquire();
+
+		/**
+		 *	@return the step last acquired
+		 */
+		const State& getState() const { return states.front(); }
+
+		/**
+		 *	@return how frames and input have been paced since the last reset
+		 */
+		Pacing getPacing() const;
+
+		void resetPacing();
+
+	protected:
+
+		static const float STEP_SECONDS;
+
+		/**
+		 *	Furthest the simulation falls behind the frames before it skips ahead,
+		 *	in seconds, so a long stall is not followed by a burst of steps
+		 */
+		static const double MAX_LAG;
+
+		WindField* field;
+		Particles* particles;
+		unsigned int cells;
+
+		unsigned int fieldRate;
+		float fieldElapsed;
+
+		/**
+		 *	State as of the last step, which is copied into each published one
+		 */
+		State current;
+
+		TripleBuffer<State> states;
+
+		/**
+		 *	Time the simulation has reached, and the time of the next frame, in
+		 *	seconds
+		 */
+		double time;
+		double target;
+
+		/**
+		 *	Input, guarded by lock
+		 */
+		float turn;
+		float dPower;
+		uint64_t input;
+		uint64_t applied;
+		Clock::time_point inputTime;
+		bool steered;
+		float steerAngle;
+		float steerPower;
+		bool scripted;
+		float scriptAngle;
+		float scriptPower;
+
+		bool threaded;
+		bool stopping;
+
+		std::thread worker;
+		std::mutex lock;
+		std::condition_variable signal;
+
+		/**
+		 *	Render thread's measurements, as sums for getPacing()
+		 */
+		unsigned int frames;
+		double intervals;
+		double intervalSquares;
+		double latencies;
+		unsigned int latencyCount;
+		float maxLatency;
+		Clock::time_point lastFrame;
+		uint64_t shownInput;
+
+		/**
+		 *	Take one step and publish it.  lock must be held, and is released
+		 *	while the step runs.
+		 */
+		void step(std::unique_lock<std::mutex>& guard);
+
+		/**
+		 *	Count a new input.  lock must be held.
+		 */
+		void stamp();
+
+		void run();
+	};
+}
@@ -0,0 +1,189 @@
+/*
+ *		WSWindField.h
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "WSRandom.h"
+
+namespace WindSim
+{
+	/**
+	 *	Wind simulated on the CPU, as a 2D velocity field over a square grid
+	 *	(stable fluids: forces, semi-Lagrangian advection, then a pressure
+	 *	projection to keep the flow free of divergence).
+	 *
+	 *	Wind blows in from the upwind edges, in the direction and at the power set
+	 *	with setWind(), with random gusts on top.  The field covers the same square
+	 *	as the wind render target, with x and y matching its x and y.
+	 *
+	 *	The grass does not follow the wind directly.  Each cell has a damped spring,
+	 *	pulled towards the wind's velocity, and the grass bends with the spring, so
+	 *	it lags behind gusts and sways back when they drop.  Every blade in a cell
+	 *	shares its spring, so the cost does not grow with the number of blades.
+	 *
+	 *	Does not depend on Nova, so can be stepped and read without a window.
+	 *	Steps can run on the field's own worker thread with stepAsync(), which is
+	 *	started the first time it is used.
+	 */
+	class WindField
+	{
+	public:
+
+		/**
+		 *	@param size : Width and height of the grid, in cells
+		 *	@param seed : Seed for the gusts.  The same seed and steps always give
+		 *	the same wind.
+		 */
+		WindField(unsigned int size, uint64_t seed);
+
+		/**
+		 *	Waits for any step in progress, and stops the worker thread
+		 */
+		~WindField();
+
+		/**
+		 *	Set the wind blowing into the field
+		 *
+		 *	@param angle : Direction the wind comes from, in degrees, as the
+		 *	Scene's emitterAngle
+		 *	@param power : Strength of the wind, from 0 to 1
+		 */
+		void setWind(float angle, float power);
+
+		/**
+		 *	Move the field forward in time, on this thread
+		 *
+		 *	@param seconds : Length of the step
+		 */
+		void step(float seconds);
+
+		/**
+		 *	Move the field forward in time on the worker thread.  The field must
+		 *	not be read or changed until wait() returns.
+		 *
+		 *	@param seconds : Length of the step
+		 */
+		void stepAsync(float seconds);
+
+		/**
+		 *	Wait for the step started by stepAsync(), if any, to finish
+		 */
+		void wait();
+
+		/**
+		 *	Colour of a cell for the wind texture, in the format WindFinal.glsl
+		 *	reads: red and blue hold the direction the grass bends on x and y,
+		 *	mapped from [-1, 1] to [0, 1], and alpha holds how far.
+		 *
+		 *	@param x : Column of the cell
+		 *	@param y : Row of the cell
+		 *	@param rgba : Receives the colour
+		 */
+		void getColour(unsigned int x, unsigned int y, float rgba[4]) const;
+
+		unsigned int getSize() const { return size; }
+
+		float getVelocityX(unsigned int x, unsigned int y) const { return velocityX[index(x, y)]; }
+		float getVelocityY(unsigned int x, unsigned int y) const { return velocityY[index(x, y)]; }
+
+		float getBendX(unsigned int x, unsigned int y) const { return bendX[index(x, y)]; }
+		float getBendY(unsigned int x, unsigned int y) const { return bendY[index(x, y)]; }
+
+	protected:
+
+		/**
+		 *	Speed of the wind at full power, in cells per second
+		 */
+		static const float SPEED;
+
+		/**
+		 *	Iterations of the pressure solve each step
+		 */
+		static const unsigned int PRESSURE_ITERATIONS = 20;
+
+		/**
+		 *	Stiffness and damping of the grass's springs, per second squared and
+		 *	per second.  Sways at about 0.7Hz, settling over a couple of swings.
+		 */
+		static const float SPRING_STIFFNESS;
+		static const float SPRING_DAMPING;
+
+		unsigned int size;
+
+		/**
+		 *	Velocity of each cell, row by row, with the previous step's alongside
+		 *	for advection
+		 */
+		std::vector<float> velocityX;
+		std::vector<float> velocityY;
+		std::vector<float> previousX;
+		std::vector<float> previousY;
+
+		std::vector<float> pressure;
+		std::vector<float> divergence;
+
+		/**
+		 *	Position and velocity of each cell's spring, in the same units as the
+		 *	wind's velocity
+		 */
+		std::vector<float> bendX;
+		std::vector<float> bendY;
+		std::vector<float> swayX;
+		std::vector<float> swayY;
+
+		/**
+		 *	Direction the wind blows towards, and its power
+		 */
+		float directionX;
+		float directionY;
+		float power;
+
+		/**
+		 *	Current gust, and the one it is easing towards
+		 */
+		float gust;
+		float gustTarget;
+		float gustTime;
+
+		SeededRandom random;
+
+		std::thread worker;
+		std::mutex lock;
+		std::condition_variable signal;
+		float pendingSeconds;
+		bool pending;
+		bool stopping;
+
+		size_t index(unsigned int x, unsigned int y) const { return static_cast<size_t>(y) * size + x; }
+
+		/**
+		 *	Bilinear sample of a field, clamped to its edges
+		 */
+		float sample(const std::vector<float>& field, float x, float y) const;
+
+		void addForces(float seconds);
+		void advect(float seconds);
+		void project();
+		void bend(float seconds);
+
+		void run();
+	};
+}
@@ -0,0 +1,154 @@
+/*
+ *		WSBenchmark.cpp
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#include "WSBenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace WindSim
+{
+	static const char* STAGE_NAMES[Benchmark::STAGES] = { "emitter", "grass", "physics", "wind", "main" };
+
+
+	Benchmark::Benchmark(unsigned int frames, const std::string& report)
+	{
+		this->frames = frames;
+		this->report = report;
+
+		frame = 0;
+		started = false;
+
+		for (std::vector<float>& stage : times)
+			stage.assign(frames, 0.0f);
+	}
+
+
+	Benchmark::Frame Benchmark::getScript(unsigned int frame)
+	{
+		const float seconds = static_cast<float>(frame * STEP) / 1000.0f;
+
+		Frame ret;
+
+		// Wind turns a full circle every 20 seconds, gusting up and down, while the
+		// camera orbits every 30
+		ret.emitterAngle = fmodf(90.0f + (seconds * 18.0f), 360.0f);
+		ret.power = 0.5f + (0.4f * sinf(seconds * 0.5f));
+		ret.cameraAngle = fmodf(90.0f + (seconds * 12.0f), 360.0f);
+
+		return ret;
+	}
+
+
+	void Benchmark::beginFrame()
+	{
+		const Clock::time_point now = Clock::now();
+
+		// The main pass of the last frame ran between its update and this one
+		if (started && frame > 0 && frame <= frames)
+			times[MAIN][frame - 1] = std::chrono::duration<float, std::milli>(now - last).count();
+
+		started = true;
+		last = now;
+	}
+
+
+	void Benchmark::mark(Stage stage)
+	{
+		const Clock::time_point now = Clock::now();
+
+		if (frame < frames)
+			times[stage][frame] += std::chrono::duration<float, std::milli>(now - last).count();
+
+		last = now;
+	}
+
+
+	void Benchmark::endFrame()
+	{
+		last = Clock::now();
+
+		frame++;
+	}
+
+
+	bool Benchmark::writeReport() const
+	{
+		std::ofstream file(report);
+
+		if (!file.is_open())
+			return false;
+
+		// Last frame's main pass was never timed
+		const size_t count = frames > 1 ? frames - 1 : frames;
+
+		std::vector<float> sorted(count);
+		std::vector<float> total(count, 0.0f);
+
+		file << "Wind Simulation benchmark: " << frames << " frames of " << STEP << "ms\n\n";
+		file << std::left << std::setw(10) << "stage" << std::right;
+
+		for (const char* column : { "mean", "p50", "p90", "p99", "max" })
+			file << std::setw(10) << column;
+
+		file << "\n" << std::fixed << std::setprecision(3);
+
+		auto writeRow = [&](const char* name)
+		{
+			double sum = 0;
+
+			for (float time : sorted)
+				sum += time;
+
+			std::sort(sorted.begin(), sorted.end());
+
+			auto percentile = [&](float p)
+			{
+				return sorted[std::min(static_cast<size_t>(p * static_cast<float>(count)), count - 1)];
+			};
+
+			file << std::left << std::setw(10) << name << std::right
+				<< std::setw(10) << sum / count
+				<< std::setw(10) << percentile(0.5f)
+				<< std::setw(10) << percentile(0.9f)
+				<< std::setw(10) << percentile(0.99f)
+				<< std::setw(10) << sorted.back() << "\n";
+		};
+
+		if (count > 0)
+		{
+			for (unsigned int stage = 0; stage < STAGES; stage++)
+			{
+				std::copy(times[stage].begin(), times[stage].begin() + count, sorted.begin());
+
+				for (size_t i = 0; i < count; i++)
+					total[i] += times[stage][i];
+
+				writeRow(STAGE_NAMES[stage]);
+			}
+
+			sorted = total;
+
+			writeRow("frame");
+		}
+
+		file.close();
+
+		return !file.fail();
+	}
+}
@@ -18,33 +18,78 @@
 
 #include "WSFinalScene.h"
 
-using Nova::Math::Random;
 using Nova::Math::Transform;
 
 namespace WindSim
 {
+	int FinalScene::start(const LaunchSettings& settings, const std::function<void()>& close)
+	{
+		int ret = 0;
+
+		auto scene = DBG_NEW FinalScene(settings.seed, settings.hashedGrass, settings.cpuWind, settings.cpuParticles,
+			settings.gusts);
+
+#if !defined(NOVA_ANDROID)
+		// Desktop only.  There App::start() runs the App until it closes, so ret
+		// outlives the scene's use of it.  On Android it returns straight away,
+		// and the frames are stepped later from Java.
+		if (settings.benchmarkFrames > 0)
+		{
+			scene->setBenchmark(settings.benchmarkFrames, "windsim_benchmark.txt", [&ret, close](int code)
+			{
+				ret = code;
+
+				if (close)
+					close();
+			});
+		}
+#endif
+
+#if defined(WS_PROFILE)
+		if (!settings.trace.empty())
+			scene->setTrace(settings.trace);
+#endif
+
+#if defined(NOVA_ANDROID)
+		// Nova on Android opens a single scene, and loads its own font
+		Nova::App::openScene(scene);
+
+		Nova::App::start();
+#else
+		Nova::App::getSceneManager().putScene("MAIN_SCENE", Nova::Scene_p(scene));
+
+		Nova::App::getContext()->loadDefaultFont("Montserrat-Regular.ttf");
+
+		Nova::App::start("MAIN_SCENE");
+#endif
+
+		return ret;
+	}
+
+
 	void FinalScene::setupField()
 	{
-		shaderFile = "WindFinal.glsl";
+		// The hashed shader shapes each blade as setupBlade() would
+		shaderFile = hashedGrass ? "WindHashed.glsl" : "WindFinal.glsl";
 
 		// Create our terrain - Blades in X, Blades in Y, Dimensions of field, culling
 		createGrass(125, 125, 50, 50, 0.6f);
 	}
 
 
-	Transform FinalScene::setupBlade(unsigned int x, unsigned int y)
+	Transform FinalScene::setupBlade(unsigned int x, unsigned int y, SeededRandom& random)
 	{
 		Transform ret;
 
-		const float bHeight = Random::randomFloat(0.5f, 1.00f);
+		const float bHeight = random.nextFloat(0.5f, 1.00f);
 
-		const float bWidth = Random::randomFloat(0.5f, 1.0f);
+		const float bWidth = random.nextFloat(0.5f, 1.0f);
 
 		ret.setRotation(
-			Random::randomFloat(-55.0f, 55.0f),
+			random.nextFloat(-55.0f, 55.0f),
 			0, 1, 0);
 
-		float offset = Random::randomFloat(-0.25f, 0.25f);
+		float offset = random.nextFloat(-0.25f, 0.25f);
 
 		ret.setPosition(offset, 0, offset);
 
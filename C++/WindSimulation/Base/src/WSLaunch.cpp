@@ -0,0 +1,67 @@
+/*
+ *		WSLaunch.cpp
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#include "WSLaunch.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+namespace WindSim
+{
+	LaunchSettings::LaunchSettings()
+	{
+		std::random_device device;
+
+		seed = (static_cast<uint64_t>(device()) << 32) | device();
+	}
+
+
+	LaunchSettings parseArguments(int argc, char** argv)
+	{
+		LaunchSettings ret;
+
+		for (int i = 1; i < argc; i++)
+		{
+			if (strcmp(argv[i], "-seed") == 0 && i + 1 < argc)
+				ret.seed = strtoull(argv[++i], nullptr, 10);
+			else if (strcmp(argv[i], "-hashed") == 0)
+				ret.hashedGrass = true;
+			else if (strcmp(argv[i], "-cpuwind") == 0)
+				ret.cpuWind = true;
+			else if (strcmp(argv[i], "-cpuparticles") == 0)
+				ret.cpuParticles = true;
+			else if (strcmp(argv[i], "-gusts") == 0 && i + 1 < argc)
+				ret.gusts = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+			else if (strcmp(argv[i], "-benchmark") == 0)
+			{
+				ret.benchmarkFrames = 1000;
+
+				if (i + 1 < argc && argv[i + 1][0] != '-')
+					ret.benchmarkFrames = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+			}
+			else if (strcmp(argv[i], "-trace") == 0)
+			{
+				ret.trace = "windsim_trace.json";
+
+				if (i + 1 < argc && argv[i + 1][0] != '-')
+					ret.trace = argv[++i];
+			}
+		}
+
+		return ret;
+	}
+}
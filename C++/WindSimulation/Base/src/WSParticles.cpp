@@ -0,0 +1,382 @@
+/*
+ *		WSParticles.cpp
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#include "WSParticles.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace WindSim
+{
+	const float Particles::EMITTER_DISTANCE = 75.0f;
+	const float Particles::EDGE = 80.0f;
+
+
+	Particles::Particles(const Settings& settings, uint64_t seed)
+		: random(seed)
+	{
+		this->settings = settings;
+
+		for (std::vector<float>* values : { &x, &y, &vx, &vy, &age, &life, &red, &blue, &alpha })
+			values->assign(settings.maxParticles, 0.0f);
+
+		count = 0;
+
+		directionX = 0.0f;
+		directionY = 1.0f;
+		power = 0.0f;
+
+		pending = 0.0f;
+
+		for (std::vector<float>* values : { &emitterX, &emitterY, &emitterVX, &emitterVY, &emitterRadius,
+			&emitterAge, &emitterLife, &emitterRate, &emitterPending })
+			values->assign(settings.emitters, 0.0f);
+
+		emitterKind.assign(settings.emitters, GUST);
+
+		// Spread through their lives, so they don't all end together
+		for (unsigned int i = 0; i < settings.emitters; i++)
+		{
+			startEmitter(i);
+
+			emitterAge[i] = random.nextFloat(0.0f, emitterLife[i]);
+		}
+	}
+
+
+	void Particles::setWind(float angle, float power)
+	{
+		const float rads = angle * 3.14159265f / 180.0f;
+
+		// Same direction of travel as the particles fired from the Scene's emitter
+		directionX = sinf(rads);
+		directionY = cosf(rads);
+
+		this->power = power;
+	}
+
+
+	void Particles::step(float seconds)
+	{
+		updateEmitters(seconds);
+
+		// Local emitters fire first, as they are short lived and most noticeable
+		for (unsigned int e = 0; e < settings.emitters; e++)
+		{
+			emitterPending[e] += emitterRate[e] * seconds;
+
+			for (; emitterPending[e] >= 1.0f && count < settings.maxParticles; emitterPending[e] -= 1.0f)
+				spawnFrom(e);
+
+			emitterPending[e] = std::min(emitterPending[e], 1.0f);
+		}
+
+		// Main emitter fires at the rate which keeps the rest of the pool full over
+		// a particle's average life
+		const float share = (settings.emitters > 0 ? 1.0f - settings.emitterShare : 1.0f);
+
+		pending += static_cast<float>(settings.maxParticles) * share * seconds * 2.0f / (settings.life[0] + settings.life[1]);
+
+		while (pending >= 1.0f && count < settings.maxParticles)
+		{
+			spawn();
+
+			pending -= 1.0f;
+		}
+
+		// No burst of particles once a full pool starts to empty
+		if (count == settings.maxParticles)
+			pending = 0.0f;
+
+		const unsigned int live = count;
+
+		float* px = x.data();
+		float* py = y.data();
+		float* pAge = age.data();
+		const float* pvx = vx.data();
+		const float* pvy = vy.data();
+
+		for (unsigned int i = 0; i < live; i++)
+		{
+			px[i] += pvx[i] * seconds;
+			py[i] += pvy[i] * seconds;
+			pAge[i] += seconds;
+		}
+
+		// Backwards, so a particle swapped into a dead one's place has already
+		// been checked
+		for (unsigned int i = live; i-- > 0;)
+		{
+			if (age[i] >= life[i] || fabsf(x[i]) > EDGE || fabsf(y[i]) > EDGE)
+				remove(i);
+		}
+	}
+
+
+	void Particles::splat(unsigned int size, float* rgba)
+	{
+		const size_t total = static_cast<size_t>(size) * size;
+		const float scale = static_cast<float>(size) / 100.0f;
+
+		// Sums of red, blue, alpha and the number of particles in each cell
+		cells.assign(total * 4, 0.0f);
+		blurred.assign(total * 4, 0.0f);
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const float cx = (x[i] + 50.0f) * scale;
+			const float cy = (y[i] + 50.0f) * scale;
+
+			if (cx < 0.0f || cy < 0.0f || cx >= static_cast<float>(size) || cy >= static_cast<float>(size))
+				continue;
+
+			float* cell = &cells[((static_cast<size_t>(cy) * size) + static_cast<size_t>(cx)) * 4];
+
+			cell[0] += red[i];
+			cell[1] += blue[i];
+			cell[2] += alpha[i];
+			cell[3] += 1.0f;
+		}
+
+		// Box blur, across then down, standing in for the size of the emitter's
+		// soft sprites
+		const int radius = static_cast<int>(settings.blur);
+		const int last = static_cast<int>(size) - 1;
+
+		for (int pass = 0; pass < 2; pass++)
+		{
+			const std::vector<float>& from = (pass == 0 ? cells : blurred);
+			std::vector<float>& to = (pass == 0 ? blurred : cells);
+
+			for (int cy = 0; cy <= last; cy++)
+			{
+				for (int cx = 0; cx <= last; cx++)
+				{
+					float* out = &to[((static_cast<size_t>(cy) * size) + cx) * 4];
+
+					out[0] = out[1] = out[2] = out[3] = 0.0f;
+
+					for (int d = -radius; d <= radius; d++)
+					{
+						const int sx = (pass == 0 ? std::min(std::max(cx + d, 0), last) : cx);
+						const int sy = (pass == 0 ? cy : std::min(std::max(cy + d, 0), last));
+						const float* in = &from[((static_cast<size_t>(sy) * size) + sx) * 4];
+
+						out[0] += in[0];
+						out[1] += in[1];
+						out[2] += in[2];
+						out[3] += in[3];
+					}
+				}
+			}
+		}
+
+		// A cell is fully covered at half the particles it would hold if they
+		// were spread evenly
+		const float window = static_cast<float>((radius * 2) + 1);
+		const float full = 0.5f * window * window * static_cast<float>(settings.maxParticles) / static_cast<float>(total);
+
+		for (size_t cell = 0; cell < total; cell++)
+		{
+			const float* sum = &cells[cell * 4];
+			float* out = &rgba[cell * 4];
+
+			if (sum[3] < 0.5f)
+			{
+				out[0] = 0.5f;
+				out[1] = 0.0f;
+				out[2] = 0.5f;
+				out[3] = 0.0f;
+
+				continue;
+			}
+
+			out[0] = sum[0] / sum[3];
+			out[1] = 0.0f;
+			out[2] = sum[1] / sum[3];
+			out[3] = (sum[2] / sum[3]) * std::min(sum[3] / full, 1.0f);
+		}
+	}
+
+
+	void Particles::spawn()
+	{
+		// Somewhere along the emitter, which faces the centre of the target
+		const float across = random.nextFloat(-0.5f, 0.5f) * settings.spread;
+		const float turn = random.nextFloat(-settings.coneAngle, settings.coneAngle) * 3.14159265f / 180.0f;
+
+		add((-EMITTER_DISTANCE * directionX) - (across * directionY),
+			(-EMITTER_DISTANCE * directionY) + (across * directionX),
+			(directionX * cosf(turn)) - (directionY * sinf(turn)),
+			(directionX * sinf(turn)) + (directionY * cosf(turn)),
+			random.nextFloat(settings.speed[0], settings.speed[1]),
+			random.nextFloat(settings.life[0], settings.life[1]),
+			random.nextFloat(power - 0.1f, power + 0.1f));
+	}
+
+
+	void Particles::spawnFrom(unsigned int emitter)
+	{
+		const float speed = random.nextFloat(settings.speed[0], settings.speed[1]);
+		const float radius = emitterRadius[emitter];
+
+		switch (emitterKind[emitter])
+		{
+		case GUST:
+		{
+			// Along the front, which runs across the wind, faster and stronger
+			// than the wind around it
+			const float across = random.nextFloat(-radius, radius);
+
+			add(emitterX[emitter] - (across * directionY), emitterY[emitter] + (across * directionX),
+				directionX, directionY, speed * 1.5f, random.nextFloat(0.5f, 1.0f),
+				std::min(power + random.nextFloat(0.2f, 0.4f), 1.0f));
+
+			break;
+		}
+
+		case VORTEX:
+		{
+			// Short lived, so their straight paths trace the circle around the
+			// centre.  Half spin each way, picked by the emitter's index.
+			const float angle = random.nextFloat(0.0f, 6.2831853f);
+			const float distance = radius * random.nextFloat(0.3f, 1.0f);
+			const float spin = (emitter % 2 == 0 ? 1.0f : -1.0f);
+
+			add(emitterX[emitter] + (cosf(angle) * distance), emitterY[emitter] + (sinf(angle) * distance),
+				-sinf(angle) * spin, cosf(angle) * spin, speed * 0.5f, random.nextFloat(0.2f, 0.5f),
+				random.nextFloat(power, power + 0.2f));
+
+			break;
+		}
+
+		default:
+		{
+			// Scattered either side of the wind's direction
+			const float angle = random.nextFloat(0.0f, 6.2831853f);
+			const float distance = radius * sqrtf(random.nextFloat(0.0f, 1.0f));
+			const float turn = random.nextFloat(-1.0f, 1.0f);
+
+			add(emitterX[emitter] + (cosf(angle) * distance), emitterY[emitter] + (sinf(angle) * distance),
+				(directionX * cosf(turn)) - (directionY * sinf(turn)),
+				(directionX * sinf(turn)) + (directionY * cosf(turn)),
+				speed * 0.5f, random.nextFloat(0.3f, 0.8f),
+				random.nextFloat(power - 0.2f, power + 0.1f));
+
+			break;
+		}
+		}
+	}
+
+
+	void Particles::add(float px, float py, float dx, float dy, float speed, float lifetime, float strength)
+	{
+		const unsigned int i = count++;
+
+		x[i] = px;
+		y[i] = py;
+		vx[i] = dx * speed;
+		vy[i] = dy * speed;
+		age[i] = 0.0f;
+		life[i] = lifetime;
+
+		// Coloured as the Scene's emitter colours its particles
+		red[i] = (dx / 2.0f) + 0.5f;
+		blue[i] = (dy / 2.0f) + 0.5f;
+		alpha[i] = std::min(std::max(strength, 0.0f), 1.0f);
+	}
+
+
+	void Particles::updateEmitters(float seconds)
+	{
+		const unsigned int emitters = settings.emitters;
+
+		for (unsigned int e = 0; e < emitters; e++)
+		{
+			emitterX[e] += emitterVX[e] * seconds;
+			emitterY[e] += emitterVY[e] * seconds;
+			emitterAge[e] += seconds;
+		}
+
+		for (unsigned int e = 0; e < emitters; e++)
+		{
+			if (emitterAge[e] >= emitterLife[e] || fabsf(emitterX[e]) > EDGE || fabsf(emitterY[e]) > EDGE)
+				startEmitter(e);
+		}
+	}
+
+
+	void Particles::startEmitter(unsigned int emitter)
+	{
+		// Half are gusts, the rest split between the other two
+		const float pick = random.nextFloat(0.0f, 1.0f);
+		const Kind kind = (pick < 0.5f ? GUST : (pick < 0.75f ? VORTEX : TURBULENCE));
+
+		float meanLife;
+
+		emitterKind[emitter] = kind;
+		emitterAge[emitter] = 0.0f;
+		emitterPending[emitter] = 0.0f;
+
+		if (kind == GUST)
+		{
+			// Starts upwind of the field, anywhere across it, and sweeps over it
+			const float across = random.nextFloat(-50.0f, 50.0f);
+			const float speed = random.nextFloat(settings.speed[0], settings.speed[1]);
+
+			emitterX[emitter] = (-50.0f * directionX) - (across * directionY);
+			emitterY[emitter] = (-50.0f * directionY) + (across * directionX);
+			emitterVX[emitter] = directionX * speed;
+			emitterVY[emitter] = directionY * speed;
+			emitterRadius[emitter] = random.nextFloat(8.0f, 20.0f);
+			emitterLife[emitter] = 100.0f / speed;
+
+			meanLife = 0.75f;
+		}
+		else
+		{
+			// Somewhere in the field, drifting slowly with the wind
+			emitterX[emitter] = random.nextFloat(-45.0f, 45.0f);
+			emitterY[emitter] = random.nextFloat(-45.0f, 45.0f);
+			emitterVX[emitter] = directionX * 5.0f;
+			emitterVY[emitter] = directionY * 5.0f;
+			emitterRadius[emitter] = random.nextFloat(5.0f, 12.0f);
+			emitterLife[emitter] = random.nextFloat(1.5f, 4.0f);
+
+			meanLife = (kind == VORTEX ? 0.35f : 0.55f);
+		}
+
+		// Each emitter's share of the pool, kept full over its particles' lives
+		emitterRate[emitter] = static_cast<float>(settings.maxParticles) * settings.emitterShare
+			/ (static_cast<float>(settings.emitters) * meanLife);
+	}
+
+
+	void Particles::remove(unsigned int index)
+	{
+		const unsigned int end = --count;
+
+		x[index] = x[end];
+		y[index] = y[end];
+		vx[index] = vx[end];
+		vy[index] = vy[end];
+		age[index] = age[end];
+		life[index] = life[end];
+		red[index] = red[end];
+		blue[index] = blue[end];
+		alpha[index] = alpha[end];
+	}
+}
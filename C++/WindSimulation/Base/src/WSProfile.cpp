@@ -0,0 +1,298 @@
+/*
+ *		WSProfile.cpp
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#include "WSProfile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+	using WindSim::Profile::Event;
+
+	/**
+	 *	Events the ring holds.  Comfortably more than a frame's worth, even while
+	 *	the grass is being built.
+	 */
+	const uint64_t CAPACITY = 16384;
+
+	static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Ring capacity must be a power of two");
+
+	/**
+	 *	Bounded multi-producer ring, with a single consumer.  Each slot's sequence
+	 *	says whether it is free for the writer at that position, or holds an event
+	 *	ready for the reader.
+	 */
+	struct Ring
+	{
+		struct Slot
+		{
+			std::atomic<uint64_t> sequence;
+			Event event;
+		};
+
+		Slot slots[CAPACITY];
+
+		std::atomic<uint64_t> head;
+		uint64_t tail;
+
+		std::atomic<uint64_t> dropped;
+
+		Ring() : head(0), tail(0), dropped(0)
+		{
+			for (uint64_t i = 0; i < CAPACITY; i++)
+				slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		void push(const Event& event)
+		{
+			uint64_t position = head.load(std::memory_order_relaxed);
+			Slot* slot;
+
+			while (true)
+			{
+				slot = &slots[position & (CAPACITY - 1)];
+
+				const int64_t diff = static_cast<int64_t>(slot->sequence.load(std::memory_order_acquire) - position);
+
+				if (diff == 0)
+				{
+					if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0)
+				{
+					// Still holds an event from the last time round
+					dropped.fetch_add(1, std::memory_order_relaxed);
+
+					return;
+				}
+				else
+					position = head.load(std::memory_order_relaxed);
+			}
+
+			slot->event = event;
+			slot->sequence.store(position + 1, std::memory_order_release);
+		}
+
+		bool pop(Event& event)
+		{
+			Slot& slot = slots[tail & (CAPACITY - 1)];
+
+			if (slot.sequence.load(std::memory_order_acquire) != tail + 1)
+				return false;
+
+			event = slot.event;
+			slot.sequence.store(tail + CAPACITY, std::memory_order_release);
+			tail++;
+
+			return true;
+		}
+	};
+
+	Ring& getRing()
+	{
+		static Ring ring;
+
+		return ring;
+	}
+
+	const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+	std::atomic<uint32_t> nextThread(0);
+
+	uint32_t getThread()
+	{
+		thread_local const uint32_t thread = nextThread++;
+
+		return thread;
+	}
+
+	/**
+	 *	Write a name as a JSON string, escaping anything which needs it
+	 */
+	void writeName(std::ostream& out, const char* name)
+	{
+		out << '"';
+
+		for (const char* c = name; *c != '\0'; c++)
+		{
+			if (*c == '"' || *c == '\\')
+				out << '\\';
+
+			out << *c;
+		}
+
+		out << '"';
+	}
+}
+
+
+namespace WindSim
+{
+	namespace Profile
+	{
+		uint64_t now()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - epoch).count());
+		}
+
+
+		void record(const char* name, uint64_t start, uint64_t end)
+		{
+			Event event;
+
+			event.name = name;
+			event.start = start;
+			event.duration = static_cast<uint32_t>(std::min<uint64_t>(end - start, UINT32_MAX));
+			event.thread = getThread();
+			event.value = 0;
+			event.counter = false;
+
+			getRing().push(event);
+		}
+
+
+		void count(const char* name, int64_t value)
+		{
+			Event event;
+
+			event.name = name;
+			event.start = now();
+			event.duration = 0;
+			event.thread = getThread();
+			event.value = value;
+			event.counter = true;
+
+			getRing().push(event);
+		}
+
+
+		size_t drain(std::vector<Event>& events)
+		{
+			Ring& ring = getRing();
+			Event event;
+			size_t drained = 0;
+
+			while (ring.pop(event))
+			{
+				events.push_back(event);
+				drained++;
+			}
+
+			return drained;
+		}
+
+
+		uint64_t getDropped()
+		{
+			return getRing().dropped.load(std::memory_order_relaxed);
+		}
+
+
+		bool writeTrace(const std::string& file, const std::vector<Event>& events)
+		{
+			std::ofstream out(file);
+
+			if (!out.is_open())
+				return false;
+
+			out << "{\"traceEvents\":[";
+
+			for (size_t i = 0; i < events.size(); i++)
+			{
+				const Event& event = events[i];
+
+				out << (i > 0 ? ",\n" : "\n") << "{\"name\":";
+				writeName(out, event.name);
+
+				if (event.counter)
+				{
+					out << ",\"ph\":\"C\",\"ts\":" << event.start << ",\"pid\":1,\"tid\":" << event.thread
+						<< ",\"args\":{\"value\":" << event.value << "}}";
+				}
+				else
+				{
+					out << ",\"ph\":\"X\",\"ts\":" << event.start << ",\"dur\":" << event.duration
+						<< ",\"pid\":1,\"tid\":" << event.thread << "}";
+				}
+			}
+
+			out << "\n]}\n";
+
+			out.close();
+
+			return !out.fail();
+		}
+
+
+		void Summary::add(const std::vector<Event>& events)
+		{
+			for (const Event& event : events)
+			{
+				// Few enough names that a search is quicker than hashing them
+				auto total = std::find_if(totals.begin(), totals.end(),
+					[&](const Total& t) { return t.counter == event.counter && strcmp(t.name, event.name) == 0; });
+
+				if (total == totals.end())
+				{
+					totals.push_back({ event.name, 0.0, 0, event.counter });
+					total = totals.end() - 1;
+				}
+
+				total->sum += event.counter ? static_cast<double>(event.value) : event.duration / 1000.0;
+				total->samples++;
+			}
+		}
+
+
+		std::string Summary::format() const
+		{
+			std::ostringstream out;
+
+			out << std::fixed << std::setprecision(3);
+
+			for (const Total& total : totals)
+			{
+				if (total.counter)
+					out << total.name << ": " << total.sum / std::max<uint64_t>(total.samples, 1) << "\n";
+				else
+					out << total.name << ": " << total.sum / std::max(frames, 1u) << "ms\n";
+			}
+
+			return out.str();
+		}
+
+
+		void Summary::reset()
+		{
+			// Keeps the names, so the lines don't jump around between updates
+			for (Total& total : totals)
+			{
+				total.sum = 0.0;
+				total.samples = 0;
+			}
+
+			frames = 0;
+		}
+	}
+}
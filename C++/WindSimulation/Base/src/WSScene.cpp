@@ -17,6 +17,13 @@
  */
 
 #include "WSScene.h"
+#include "WSAllocations.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 using Nova::Colour;
 using Nova::Input_p;
@@ -27,11 +34,54 @@ using namespace Nova::Math;
 
 using std::shared_ptr;
 
+namespace
+{
+	/**
+	 *	Segments in each blade of grass, from the nearest level of detail to the furthest
+	 */
+	const unsigned int GRASS_SEGMENTS[] = { 5, 2, 1 };
+
+	static_assert(sizeof(GRASS_SEGMENTS) / sizeof(GRASS_SEGMENTS[0]) == WindSim::Scene::GRASS_LODS,
+		"Need a segment count for each level of detail");
+
+	/**
+	 *	Distance from the camera beyond which each level of detail is replaced by the next
+	 */
+	const float GRASS_LOD_DISTANCE[] = { 62.0f, 78.0f };
+
+	/**
+	 *	Cosine of the widest angle from the view direction a tile can be seen at
+	 */
+	const float GRASS_VIEW_COS = 0.7f;
+}
+
 namespace WindSim
 {
-	Scene::Scene()
+	Scene::Scene(uint64_t seed, bool hashedGrass, bool cpuWind, bool cpuParticles, unsigned int gusts)
 		: rads(static_cast<float>(M_PI) / 180.0f)
 	{
+		fieldSeed = seed;
+		this->hashedGrass = hashedGrass;
+		this->cpuWind = cpuWind;
+		this->cpuParticles = cpuParticles && !cpuWind;
+		this->gusts = gusts;
+
+		windMillis = 0;
+		windFrames = 0;
+		windElapsed = 0;
+		windAllocations = 0;
+		displayTime = 0.0;
+		benchmarkDone = false;
+
+#if defined(NOVA_ANDROID)
+		joystickMoved = false;
+#endif
+		windStep = 0;
+		windDrawn = false;
+
+		shownPower = -1;
+		emitterColour = 0;
+
 		cameraAngle = 90;
 		emitterAngle = 90;
 		vCamera = 0;
@@ -47,6 +97,57 @@ namespace WindSim
 	}
 
 
+	void Scene::setBenchmark(unsigned int frames, const std::string& report, const std::function<void(int)>& finished)
+	{
+		benchmark = std::unique_ptr<Benchmark>(DBG_NEW Benchmark(frames, report));
+		benchmarkFinished = finished;
+	}
+
+
+#if defined(WS_PROFILE)
+	void Scene::setTrace(const std::string& file)
+	{
+		traceFile = file;
+	}
+
+
+	void Scene::updateProfile()
+	{
+		profileEvents.clear();
+		Profile::drain(profileEvents);
+
+		profileSummary.add(profileEvents);
+		profileSummary.endFrame();
+
+		if (!traceFile.empty())
+			trace.insert(trace.end(), profileEvents.begin(), profileEvents.end());
+
+		if (profileSummary.getFrames() == 60)
+		{
+			textProfile.setText(profileSummary.format()
+				+ "dropped events: " + std::to_string(Profile::getDropped()));
+
+			profileSummary.reset();
+		}
+	}
+
+
+	void Scene::writeTrace()
+	{
+		if (traceFile.empty())
+			return;
+
+		// Anything still in the ring, such as the last frame's update
+		Profile::drain(trace);
+
+		Profile::writeTrace(traceFile, trace);
+
+		traceFile.clear();
+		trace = std::vector<Profile::Event>();
+	}
+#endif
+
+
 	void Scene::resize(Nova::MainStage_p& mainStage, int width, int height)
 	{
 		auto fWidth = static_cast<float>(width);
@@ -60,12 +161,65 @@ namespace WindSim
 
 	void Scene::createScenes(const Nova::Context_p& context, Nova::MainStage_p& mainStage)
 	{
-		// Render texture to store the wind effect
-		wind = context->getStageFactory()->newSubStage();
-		wind->open(context->getImageFactory(), 100, 100);
-		wind->setProjectionMatrix(Matrix::ortho(-50, 50, -50, 50, 1, 2))
-			.setViewMatrix(Matrix::view(0, 0, 1, 0, 0, 0, 0, 1, 0))
-			.setBaseColour(Colour::NONE);
+		// Render textures to store the wind effect, one drawn into while the other
+		// is read
+		for (Nova::SubStage_p* target : { &wind, &windFront })
+		{
+			*target = context->getStageFactory()->newSubStage();
+			(*target)->open(context->getImageFactory(), 100, 100);
+			(*target)->setProjectionMatrix(Matrix::ortho(-50, 50, -50, 50, 1, 2))
+				.setViewMatrix(Matrix::view(0, 0, 1, 0, 0, 0, 0, 1, 0))
+				.setBaseColour(Colour::NONE);
+		}
+	}
+
+
+	void Scene::drawWind(const Simulation::State& state)
+	{
+		if (!windCells.empty())
+		{
+			// One soft sprite per cell of the field, or of the grid the particles
+			// are splatted into, draws it into the wind texture
+			for (unsigned int cell = 0; cell < WIND_CELLS * WIND_CELLS; cell++)
+			{
+				const float* rgba = &state.wind[cell * 4];
+
+				static_cast<Nova::ModelProp*>(windCells[cell]->getProp())->getData().colour =
+					Colour::fromFloat(rgba[0], rgba[1], rgba[2], rgba[3]);
+
+				wind->add(windCells[cell].get());
+			}
+		}
+		else
+		{
+			windEmitter->updatePhysics(static_cast<long>(1000 / WIND_RATE));
+
+			wind->add(windEmitter.get());
+		}
+
+		if (benchmark)
+			benchmark->mark(Benchmark::PHYSICS);
+
+		wind->render(getContext()->getRenderer());
+
+		wind->clear();
+
+		if (benchmark)
+			benchmark->mark(Benchmark::WIND);
+	}
+
+
+	void Scene::swapWind()
+	{
+		std::swap(wind, windFront);
+
+		const Nova::Image_p texture = windFront->getRenderTexture();
+
+		for (GrassTile& grass : grassTiles)
+			grass.prop->setTexture(texture);
+
+		// windEffect and windOverlay are not shown, so are left on the target
+		// they were set up with, rather than rebuilt on every swap
 	}
 
 
@@ -79,21 +233,49 @@ namespace WindSim
 		framerateText->setFrequency(5000);
 
 
-		textPower.setText("Wind Power: "
-			+ std::to_string(static_cast<int>((power - 0.1f) * 100))
-			+ " to "
-			+ std::to_string(static_cast<int>((power + 0.1f) * 100)))
-			.setFontSize(25)
+		textPower.setFontSize(25)
 			.setColour(Nova::Colour::WHITE)
 			.setOrigin(0.0f, 1.0f);
 		textPower.getTransform().setPosition(0.05f, 0.95f, 0);
 
+		updatePowerText();
+
 
 		framerateText->addToStage(mainStage->getUI());
 		addContent(framerateText);
 
 		mainStage->getUI()->add(&textPower);
 
+		textGrass.setFontSize(16)
+			.setColour(Nova::Colour::WHITE)
+			.setOrigin(0.0f, 1.0f);
+		textGrass.getTransform().setPosition(0.05f, 0.9f, 0);
+
+		mainStage->getUI()->add(&textGrass);
+
+		textWind.setFontSize(16)
+			.setColour(Nova::Colour::WHITE)
+			.setOrigin(0.0f, 1.0f);
+		textWind.getTransform().setPosition(0.05f, 0.87f, 0);
+
+		mainStage->getUI()->add(&textWind);
+
+		textPacing.setFontSize(16)
+			.setColour(Nova::Colour::WHITE)
+			.setOrigin(0.0f, 1.0f);
+		textPacing.getTransform().setPosition(0.05f, 0.84f, 0);
+
+		mainStage->getUI()->add(&textPacing);
+
+#if defined(WS_PROFILE)
+		textProfile.setFontSize(16)
+			.setColour(Nova::Colour::WHITE)
+			.setOrigin(0.0f, 1.0f);
+		textProfile.getTransform().setPosition(0.05f, 0.81f, 0);
+
+		mainStage->getUI()->add(&textProfile);
+#endif
+
 
 		Nova::TextWidget* tName = DBG_NEW Nova::TextWidget();
 
@@ -117,7 +299,7 @@ namespace WindSim
 		mainStage->getUI()->add(tExit);
 #endif
 
-		windEffect.setImage(wind->getRenderTexture(), 450, 450);
+		windEffect.setImage(windFront->getRenderTexture(), 450, 450);
 		windEffect.getTransform().setPosition(1.0f, 1.0f, 0);
 		windEffect.setOrigin(1.0f, 1.0f);
 
@@ -172,28 +354,175 @@ namespace WindSim
 
 	void Scene::update(long millis)
 	{
-		const float seconds = static_cast<float>(millis) / 1000.0f;
+		// Frames until the App closes, after a benchmark has finished
+		if (benchmarkDone)
+			return;
+
+		WS_PROFILE_SCOPE("Scene::update");
+
+#if defined(NOVA_ANDROID)
+		// Everything queued since the last frame, merged into one steer
+		for (unsigned int i = 0; i < MAX_EVENTS; i++)
+		{
+			const Input_p event = getContext()->getEvent();
 
-		vEmitter = 0.15f;
+			if (event == nullptr)
+				break;
 
-		if (eUpdate || vEmitter != 0 || dPower != 0)
+			handleInput(event);
+		}
+
+		applyInput();
+#endif
+
+		if (benchmark)
 		{
-			updateEmitter(seconds);
-			textPower.setText("Wind Power: "
-				+ std::to_string(static_cast<int>((power - 0.1f) * 100))
-				+ " to "
-				+ std::to_string(static_cast<int>((power + 0.1f) * 100)));
+			benchmark->beginFrame();
+
+			// Scripted timeline, stepped by a fixed time, in place of the user's input
+			const Benchmark::Frame script = Benchmark::getScript(benchmark->getFrame());
+
+			millis = Benchmark::STEP;
+			cameraAngle = script.cameraAngle;
+
+			simulation->setScript(script.emitterAngle, script.power);
+
+			setupCamera(mainStage);
+		}
+
+		const auto windStart = std::chrono::steady_clock::now();
+		const uint64_t allocationStart = Allocations::getCount();
+
+		// The simulation runs ahead to this frame's time on its own thread, and
+		// the newest step it has finished is shown
+		displayTime += static_cast<double>(millis) / 1000.0;
+
+		simulation->frame(displayTime);
+
+		if (simulation->acquire())
+		{
+			const Simulation::State& state = simulation->getState();
+
+			if (state.emitterAngle != emitterAngle || state.power != power)
+			{
+				emitterAngle = state.emitterAngle;
+				power = state.power;
+
+				eUpdate = true;
+			}
+		}
+
+		if (benchmark)
+			benchmark->mark(Benchmark::PHYSICS);
+
+		if (eUpdate)
+		{
+			updateEmitter();
+			updatePowerText();
 
 			eUpdate = false;
 		}
 
-		windEmitter->updatePhysics(millis);
+		if (benchmark)
+			benchmark->mark(Benchmark::EMITTER);
 
-		wind->add(windEmitter.get());
+		updateGrass();
 
-		wind->render(getContext()->getRenderer());
+		if (benchmark)
+			benchmark->mark(Benchmark::GRASS);
 
-		wind->clear();
+		// The wind is drawn at its own rate.  Each tick the target drawn last tick,
+		// if any, is swapped in for the grass, and the next update is drawn into
+		// the other, which nothing reads until the tick after.  The CPU wind and
+		// particles are only drawn again once the simulation has changed them.  Time left over is
+		// kept, so the rate holds when frames don't divide it evenly, but no more
+		// than one tick's worth builds up after a stall.
+		const long windPeriod = static_cast<long>(1000 / WIND_RATE);
+
+		windElapsed = std::min(windElapsed + millis, windPeriod * 2);
+
+		if (windElapsed >= windPeriod)
+		{
+			WS_PROFILE_SCOPE("wind pass");
+
+			if (windDrawn)
+			{
+				swapWind();
+
+				windDrawn = false;
+			}
+
+			const Simulation::State& state = simulation->getState();
+
+			if (windCells.empty() || state.windStep != windStep)
+			{
+				windStep = state.windStep;
+				windDrawn = true;
+
+				drawWind(state);
+			}
+
+			windElapsed -= windPeriod;
+		}
+
+		// Average cost of the wind each frame, for comparing the two methods
+		windMillis += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - windStart).count();
+
+		windAllocations += Allocations::getCount() - allocationStart;
+
+		WS_PROFILE_COUNT("allocations", Allocations::getCount() - allocationStart);
+
+		if (++windFrames == 60)
+		{
+			std::string method = (windField ? "CPU wind: " : "Particle wind: ");
+
+			if (particles)
+			{
+				const Simulation::State& state = simulation->getState();
+
+				method = "CPU particles (" + std::to_string(state.particles) + ", "
+					+ std::to_string(static_cast<int>(static_cast<float>(state.particles) / std::max(state.particleMillis, 0.001f)))
+					+ " per ms): ";
+			}
+
+			textWind.setText(method
+				+ std::to_string(windMillis / static_cast<float>(windFrames)).substr(0, 5) + "ms, "
+				+ std::to_string(windAllocations / windFrames) + " allocations per frame");
+
+			windMillis = 0;
+			windFrames = 0;
+			windAllocations = 0;
+
+			const Simulation::Pacing pacing = simulation->getPacing();
+
+			textPacing.setText("Frames " + std::to_string(pacing.interval).substr(0, 5)
+				+ "ms apart, jitter " + std::to_string(pacing.jitter).substr(0, 5)
+				+ "ms, input shown after " + std::to_string(pacing.latency).substr(0, 5)
+				+ "ms (worst " + std::to_string(pacing.maxLatency).substr(0, 5) + "ms)");
+
+			simulation->resetPacing();
+		}
+
+		if (benchmark)
+		{
+			benchmark->endFrame();
+
+			// Nothing more to do once the report is written.  The scene is torn
+			// down with the App, through release().
+			if (benchmark->isFinished())
+			{
+				const bool written = benchmark->writeReport();
+
+				benchmarkDone = true;
+
+				if (benchmarkFinished)
+					benchmarkFinished(written ? 0 : 1);
+			}
+		}
+
+#if defined(WS_PROFILE)
+		updateProfile();
+#endif
 
 		//windEffect.invalidate();
 
@@ -213,149 +542,326 @@ namespace WindSim
 
 	void Scene::release()
 	{
+#if defined(WS_PROFILE)
+		writeTrace();
+#endif
 
+		simulation.reset();
+		windField.reset();
+		particles.reset();
+		windCells.clear();
+		grassTiles.clear();
+		grassScratch = std::vector<GrassScratch>();
 	}
 
 
 	void Scene::createGrass(unsigned int bladesX, unsigned int bladesY, unsigned int width,
 		unsigned int height, float cull)
 	{
-		std::shared_ptr<Nova::SimpleActor> grass = Nova::create<Nova::SimpleActor>();
-		Nova::Model_p grassModel = getContext()->getModelFactory()->newModel();
-		Model::Data data{};
-		auto grassProp = DBG_NEW Nova::ModelProp();
-
 		terrain->getTransform().setScale(static_cast<float>(width), static_cast<float>(height), 1.0f);
 
 		// blades = 100, width = 50, 50 / 100 = 0.5
-		const float spacingX = static_cast<float>(width) / static_cast<float>(bladesX);
-		const float spacingY = static_cast<float>(height) / static_cast<float>(bladesY);
-		// 12 vertices per blade
-		// 3 points per face
-		// 100 blades
-		// = 3300
-
-		data.vertices = DBG_NEW float[36 * bladesX * bladesY];
-		data.uvs = DBG_NEW float[24 * bladesX * bladesY];
-		data.indices = DBG_NEW unsigned int[30 * bladesX * bladesY];
-
-		data.info.cElements = 0;
-		data.info.cIndices = 0;
-		unsigned int vIndex = 0;
-		unsigned int uIndex = 0;
+		grassLayout.bladesX = bladesX;
+		grassLayout.bladesY = bladesY;
+		grassLayout.spacingX = static_cast<float>(width) / static_cast<float>(bladesX);
+		grassLayout.spacingY = static_cast<float>(height) / static_cast<float>(bladesY);
+		grassLayout.cull = cull;
+		grassLayout.tilesX = (bladesX + GRASS_TILE - 1) / GRASS_TILE;
+		grassLayout.tilesY = (bladesY + GRASS_TILE - 1) / GRASS_TILE;
+
+		const unsigned int tiles = grassLayout.tilesX * grassLayout.tilesY;
+		const unsigned int meshes = tiles * GRASS_LODS;
+
+		WS_PROFILE_SCOPE("Scene::createGrass");
+
+		const auto start = std::chrono::steady_clock::now();
+
+		// Every mesh of every tile is built on its own, so they are shared out
+		// between one thread per core.  Each blade has its own random stream, so
+		// the field is the same however the work is split.
+		const unsigned int threads = std::min(std::max(std::thread::hardware_concurrency(), 1u), meshes);
+
+		std::vector<std::thread> workers;
+		std::atomic<unsigned int> nextMesh(0);
+
+		grassScratch.resize(meshes);
+
+		auto worker = [&]()
+		{
+			unsigned int mesh;
+
+			WS_PROFILE_SCOPE("grass build");
+
+			while ((mesh = nextMesh++) < meshes)
+				buildGrassMesh(grassScratch[mesh], mesh / GRASS_LODS, GRASS_SEGMENTS[mesh % GRASS_LODS]);
+		};
+
+		for (unsigned int i = 1; i < threads; i++)
+			workers.emplace_back(worker);
+
+		worker();
+
+		for (std::thread& t : workers)
+			t.join();
+
+		const float millis = std::chrono::duration<float, std::milli>(
+			std::chrono::steady_clock::now() - start).count();
+
+		unsigned int blades = 0;
+
+		for (unsigned int tile = 0; tile < tiles; tile++)
+			blades += grassScratch[tile * GRASS_LODS].blades;
+
+		textGrass.setText(std::to_string(blades) + " blades in "
+			+ std::to_string(static_cast<int>(millis)) + "ms ("
+			+ std::to_string(static_cast<int>(static_cast<float>(blades) / std::max(millis, 0.001f)))
+			+ " blades/ms)");
+
+		Nova::Shader_p shader = getContext()->getShaderFactory()->newShader();
+		shader->load(shaderFile, getContext()->getAssetFactory());
+		shader->build();
+		shader->cleanUp();
+
+		// Models are created on this thread, which owns the Context
+		grassTiles.resize(tiles);
+
+		for (unsigned int tile = 0; tile < tiles; tile++)
+		{
+			GrassTile& grass = grassTiles[tile];
+			const unsigned int x = (tile % grassLayout.tilesX) * GRASS_TILE;
+			const unsigned int y = (tile / grassLayout.tilesX) * GRASS_TILE;
+
+			for (unsigned int lod = 0; lod < GRASS_LODS; lod++)
+			{
+				GrassScratch& scratch = grassScratch[(tile * GRASS_LODS) + lod];
+				Model::Data data{};
+
+				data.vertices = scratch.vertices.data();
+				data.uvs = scratch.uvs.data();
+				data.indices = scratch.indices.data();
+				data.info.cElements = static_cast<unsigned int>(scratch.vertices.size() / 3);
+				data.info.cIndices = static_cast<unsigned int>(scratch.indices.size());
+
+				grass.lods[lod] = getContext()->getModelFactory()->newModel();
+				grass.lods[lod]->createFromData(data);
+				grass.lods[lod]->build();
+				grass.lods[lod]->cleanUp();
+			}
+
+			// Centre of the tile, in the same space as the camera
+			grass.centreX = ((x + std::min(x + GRASS_TILE, bladesX)) / 2.0f) * grassLayout.spacingX - (width / 2.0f);
+			grass.centreZ = ((y + std::min(y + GRASS_TILE, bladesY)) / 2.0f) * grassLayout.spacingY - (height / 2.0f);
+			grass.lod = 0;
+
+			grass.prop = DBG_NEW Nova::ModelProp();
+			grass.prop->setModel(grass.lods[0]);
+			grass.prop->setTexture(windFront->getRenderTexture());
+			grass.prop->getData().colour = Colour::GREEN;
+			grass.prop->getData().transMask = Colour::NONE;
+			grass.prop->setShader(shader);
+
+			grass.actor = Nova::create<Nova::SimpleActor>();
+			grass.actor->setProp(grass.prop);
+			grass.actor->getTransform().setPosition(-(width / 2.0f), 0, -(height / 2.0f));
+
+			addContent(grass.actor);
+		}
+
+		updateGrass();
+	}
+
+
+	void Scene::buildGrassMesh(GrassScratch& mesh, unsigned int tile, unsigned int segments)
+	{
+		const unsigned int x0 = (tile % grassLayout.tilesX) * GRASS_TILE;
+		const unsigned int y0 = (tile / grassLayout.tilesX) * GRASS_TILE;
+		const unsigned int x1 = std::min(x0 + GRASS_TILE, grassLayout.bladesX);
+		const unsigned int y1 = std::min(y0 + GRASS_TILE, grassLayout.bladesY);
+
+		// Two vertices across the bottom of the blade, and two more at the top of
+		// each segment
+		const unsigned int bladeVertices = (segments + 1) * 2;
+		const unsigned int bladeIndices = segments * 6;
 
 		const float uvOffset = 0.25f;
 
+		const SeededRandom field(fieldSeed);
+
 		Vector vertex;
 		Transform transform;
 		Matrix bTransform;
 
-		// Creating each blade separately, but they all form part of the same model
-		for (unsigned int y = 0; y < bladesY; y++)
+		// First pass counts the blades left after culling, which only needs the
+		// first number from each blade's stream, so the buffers are sized exactly
+		mesh.blades = 0;
+
+		for (unsigned int y = y0; y < y1; y++)
 		{
-			for (unsigned int x = 0; x < bladesX; x++)
+			for (unsigned int x = x0; x < x1; x++)
 			{
-				if (Random::randomFloat(0.0f, 1.0f) < cull)
-					continue;
+				SeededRandom random = field.split(static_cast<uint64_t>(y) * grassLayout.bladesX + x);
 
-				transform = setupBlade(x, y);
+				if (random.nextFloat(0.0f, 1.0f) >= grassLayout.cull)
+					mesh.blades++;
+			}
+		}
 
-				transform.move(x * spacingX, 0, y * spacingY);
+		// Kept between builds, so rebuilding a field no larger than the last
+		// allocates nothing
+		mesh.vertices.resize(static_cast<size_t>(mesh.blades) * bladeVertices * 3);
+		mesh.uvs.resize(static_cast<size_t>(mesh.blades) * bladeVertices * 2);
+		mesh.indices.resize(static_cast<size_t>(mesh.blades) * bladeIndices);
 
-				bTransform = transform.getMatrix();
+		unsigned int blade = 0;
 
-				// Height divided by 5 segments
-				float hSpacing = transform.getScale().y / 5.0f;
+		for (unsigned int y = y0; y < y1; y++)
+		{
+			const float v = uvOffset + ((1.0f - (static_cast<float>(y) /
+				static_cast<float>(grassLayout.bladesY))) / 2.0f);
 
-				for (int i = 0; i < 12; i++)
-				{
-					vertex.x = (i % 2 == 0 ? -0.15f : 0.15f);
-					vertex.y = hSpacing * (i % 2 == 0 ? i : i - 1);
-					vertex.z = 0.0f;
+			for (unsigned int x = x0; x < x1; x++)
+			{
+				// Each blade has its own stream, so it does not depend on the blades before it
+				SeededRandom random = field.split(static_cast<uint64_t>(y) * grassLayout.bladesX + x);
 
-					vertex = bTransform * vertex;
+				if (random.nextFloat(0.0f, 1.0f) < grassLayout.cull)
+					continue;
 
-					data.vertices[vIndex + (i * 3)] = vertex.x;
-					data.vertices[vIndex + (i * 3) + 1] = vertex.y;
-					data.vertices[vIndex + (i * 3) + 2] = vertex.z;
+				float* vertices = mesh.vertices.data() + (static_cast<size_t>(blade) * bladeVertices * 3);
+				float* uvs = mesh.uvs.data() + (static_cast<size_t>(blade) * bladeVertices * 2);
+				unsigned int* indices = mesh.indices.data() + (static_cast<size_t>(blade) * bladeIndices);
 
-					data.uvs[uIndex + (i * 2)] = uvOffset + ((static_cast<float>(x) /
-						static_cast<float>(bladesX)) / 2.0f);
-					data.uvs[uIndex + (i * 2) + 1] = uvOffset + ((1.0f - (static_cast<float>(y) /
-						static_cast<float>(bladesY))) /
-						2.0f);
+				if (hashedGrass)
+				{
+					// The key, each vertex's height up the blade in 60ths, and its side
+					// share the y, within the 24 bits a float holds exactly
+					const auto key = static_cast<unsigned int>(random.next() >> 48);
+
+					for (unsigned int i = 0; i < bladeVertices; i++)
+					{
+						const unsigned int rise = ((i / 2) * 60) / segments;
+
+						vertices[i * 3] = x * grassLayout.spacingX;
+						vertices[(i * 3) + 1] = static_cast<float>((key << 8) | (rise << 1) | (i % 2));
+						vertices[(i * 3) + 2] = y * grassLayout.spacingY;
+					}
 				}
+				else
+				{
+					transform = setupBlade(x, y, random);
 
-				data.indices[data.info.cIndices] = data.info.cElements;
-				data.indices[data.info.cIndices + 1] = data.info.cElements + 1;
-				data.indices[data.info.cIndices + 2] = data.info.cElements + 2;
+					transform.move(x * grassLayout.spacingX, 0, y * grassLayout.spacingY);
 
-				data.indices[data.info.cIndices + 3] = data.info.cElements + 3;
-				data.indices[data.info.cIndices + 4] = data.info.cElements + 2;
-				data.indices[data.info.cIndices + 5] = data.info.cElements + 1;
+					bTransform = transform.getMatrix();
 
-				data.indices[data.info.cIndices + 6] = data.info.cElements + 2;
-				data.indices[data.info.cIndices + 7] = data.info.cElements + 3;
-				data.indices[data.info.cIndices + 8] = data.info.cElements + 4;
+					// Top of the blade is at twice its height, before it is scaled
+					const float hSpacing = (transform.getScale().y * 2.0f) / static_cast<float>(segments);
 
-				data.indices[data.info.cIndices + 9] = data.info.cElements + 5;
-				data.indices[data.info.cIndices + 10] = data.info.cElements + 4;
-				data.indices[data.info.cIndices + 11] = data.info.cElements + 3;
+					// The blade is flat in its own XY plane, so transforming its root and
+					// two edges gives everything needed to place the other vertices
+					float base[3], side[3], rise[3];
 
-				data.indices[data.info.cIndices + 12] = data.info.cElements + 6;
-				data.indices[data.info.cIndices + 13] = data.info.cElements + 4;
-				data.indices[data.info.cIndices + 14] = data.info.cElements + 5;
+					vertex.x = 0.0f;
+					vertex.y = 0.0f;
+					vertex.z = 0.0f;
+					vertex = bTransform * vertex;
 
-				data.indices[data.info.cIndices + 15] = data.info.cElements + 7;
-				data.indices[data.info.cIndices + 16] = data.info.cElements + 6;
-				data.indices[data.info.cIndices + 17] = data.info.cElements + 5;
+					base[0] = vertex.x;
+					base[1] = vertex.y;
+					base[2] = vertex.z;
 
-				data.indices[data.info.cIndices + 18] = data.info.cElements + 6;
-				data.indices[data.info.cIndices + 19] = data.info.cElements + 7;
-				data.indices[data.info.cIndices + 20] = data.info.cElements + 8;
+					vertex.x = 0.15f;
+					vertex.y = 0.0f;
+					vertex.z = 0.0f;
+					vertex = bTransform * vertex;
 
-				data.indices[data.info.cIndices + 21] = data.info.cElements + 9;
-				data.indices[data.info.cIndices + 22] = data.info.cElements + 8;
-				data.indices[data.info.cIndices + 23] = data.info.cElements + 7;
+					side[0] = vertex.x - base[0];
+					side[1] = vertex.y - base[1];
+					side[2] = vertex.z - base[2];
 
-				data.indices[data.info.cIndices + 24] = data.info.cElements + 8;
-				data.indices[data.info.cIndices + 25] = data.info.cElements + 9;
-				data.indices[data.info.cIndices + 26] = data.info.cElements + 10;
+					vertex.x = 0.0f;
+					vertex.y = hSpacing;
+					vertex.z = 0.0f;
+					vertex = bTransform * vertex;
+
+					rise[0] = vertex.x - base[0];
+					rise[1] = vertex.y - base[1];
+					rise[2] = vertex.z - base[2];
+
+					// Left then right vertex of each row, as straight-line arithmetic
+					// the compiler can vectorise
+					for (unsigned int row = 0; row <= segments; row++)
+					{
+						for (unsigned int c = 0; c < 3; c++)
+						{
+							const float centre = base[c] + (static_cast<float>(row) * rise[c]);
+
+							vertices[(row * 6) + c] = centre - side[c];
+							vertices[(row * 6) + 3 + c] = centre + side[c];
+						}
+					}
+				}
 
-				data.indices[data.info.cIndices + 27] = data.info.cElements + 11;
-				data.indices[data.info.cIndices + 28] = data.info.cElements + 10;
-				data.indices[data.info.cIndices + 29] = data.info.cElements + 9;
+				const float u = uvOffset + ((static_cast<float>(x) /
+					static_cast<float>(grassLayout.bladesX)) / 2.0f);
 
-				vIndex += 36;
-				uIndex += 24;
-				data.info.cIndices += 30;
-				data.info.cElements += 12;
+				for (unsigned int i = 0; i < bladeVertices; i++)
+				{
+					uvs[i * 2] = u;
+					uvs[(i * 2) + 1] = v;
+				}
+
+				// Two triangles for each segment
+				for (unsigned int i = 0; i < segments; i++)
+				{
+					const unsigned int first = (blade * bladeVertices) + (i * 2);
+
+					indices[(i * 6)] = first;
+					indices[(i * 6) + 1] = first + 1;
+					indices[(i * 6) + 2] = first + 2;
+					indices[(i * 6) + 3] = first + 3;
+					indices[(i * 6) + 4] = first + 2;
+					indices[(i * 6) + 5] = first + 1;
+				}
+
+				blade++;
 			}
 		}
+	}
 
-		Nova::Shader_p shader = getContext()->getShaderFactory()->newShader();
-		shader->load(shaderFile, getContext()->getAssetFactory());
-		shader->build();
-		shader->cleanUp();
 
-		grassModel->createFromData(data);
-		grassModel->build();
-		grassModel->cleanUp();
+	void Scene::updateGrass()
+	{
+		WS_PROFILE_SCOPE("Scene::updateGrass");
+
+		// Camera orbits as in setupCamera(), looking at the centre of the field
+		const float camera[3] = { 50.0f * cosf(cameraAngle * rads), 50.0f, 50.0f * sinf(cameraAngle * rads) };
+		const float length = sqrtf((camera[0] * camera[0]) + (camera[1] * camera[1]) + (camera[2] * camera[2]));
 
-		grassProp->setModel(grassModel);
-		grassProp->setTexture(wind->getRenderTexture());
-		grassProp->getData().colour = Colour::GREEN;
-		grassProp->getData().transMask = Colour::NONE;
-		grassProp->setShader(shader);
+		for (GrassTile& grass : grassTiles)
+		{
+			const float toTile[3] = { grass.centreX - camera[0], -camera[1], grass.centreZ - camera[2] };
+			const float distance = sqrtf((toTile[0] * toTile[0]) + (toTile[1] * toTile[1]) + (toTile[2] * toTile[2]));
+
+			// Cosine of the angle between the view direction and the tile
+			const float facing = -((toTile[0] * camera[0]) + (toTile[1] * camera[1]) + (toTile[2] * camera[2]))
+				/ (distance * length);
 
-		grass->setProp(grassProp);
-		grass->getTransform().setPosition(-(width / 2.0f), 0, -(height / 2.0f));
+			unsigned int lod = 0;
 
-		addContent(grass);
+			while (lod + 1 < GRASS_LODS && distance > GRASS_LOD_DISTANCE[lod])
+				lod++;
 
-		delete[] data.vertices;
-		delete[] data.uvs;
-		delete[] data.indices;
+			// Tiles outside the view get the cheapest mesh
+			if (facing < GRASS_VIEW_COS)
+				lod = GRASS_LODS - 1;
+
+			if (lod != grass.lod)
+			{
+				grass.prop->setModel(grass.lods[lod]);
+				grass.lod = lod;
+			}
+		}
 	}
 
 
@@ -390,6 +896,9 @@ namespace WindSim
 
 		prop->setup(settings);
 
+		// Kept, so updateEmitter() only has to change the colours
+		windSettings = settings;
+
 		windEmitter->setProp(prop);
 
 		// Setup the Sprite showing wind direction
@@ -407,8 +916,61 @@ namespace WindSim
 			.rotate(0, 0, 1, 0);
 
 
+		if (cpuWind || cpuParticles)
+		{
+			// Own stream for the gusts or particles, apart from the blades' streams
+			const uint64_t windSeed = SeededRandom(fieldSeed).split(~0ull).next();
+
+			if (cpuWind)
+				windField = std::unique_ptr<WindField>(DBG_NEW WindField(WIND_CELLS, windSeed));
+			else
+			{
+				// Nova's emitter is set up for 1000
+				Particles::Settings particleSettings;
+
+				particleSettings.maxParticles = 100000;
+				particleSettings.emitters = gusts;
+
+				particles = std::unique_ptr<Particles>(DBG_NEW Particles(particleSettings, windSeed));
+			}
+
+			Nova::Model_p plane = getContext()->getModelFactory()->newModel();
+
+			plane->createFromData(getContext()->getRenderer()->getPlane());
+			plane->build();
+			plane->cleanUp();
+
+			// Cells cover the wind target's 100 x 100 view, and overlap their
+			// neighbours so the field blends smoothly between them
+			const float cellSize = 100.0f / static_cast<float>(WIND_CELLS);
+
+			for (unsigned int y = 0; y < WIND_CELLS; y++)
+			{
+				for (unsigned int x = 0; x < WIND_CELLS; x++)
+				{
+					shared_ptr<SimpleActor> cell = Nova::create<SimpleActor>();
+					auto cellProp = DBG_NEW Nova::ModelProp();
+
+					cellProp->setModel(plane);
+					cellProp->setTexture(particle);
+					cellProp->getData().colour = Colour::NONE;
+					cellProp->getData().transMask = Colour::NONE;
+
+					cell->setProp(cellProp);
+					cell->getTransform().setPosition(-50.0f + ((x + 0.5f) * cellSize), -50.0f + ((y + 0.5f) * cellSize), 0)
+						.setScale(cellSize * 2.0f, cellSize * 2.0f, 1);
+
+					windCells.push_back(cell);
+				}
+			}
+		}
+
+		// Benchmarks step on this thread, so every run takes the same steps
+		simulation = std::unique_ptr<Simulation>(
+			DBG_NEW Simulation(emitterAngle, power, windField.get(), particles.get(), WIND_CELLS, WIND_RATE, !benchmark));
+
 		// Setup the emitter and wind direction to face the right way when the scene starts
-		updateEmitter(0);
+		updateEmitter();
 
 		// Adds the wind effect overlay to scene
 
@@ -416,7 +978,7 @@ namespace WindSim
 
         auto overlay = DBG_NEW Nova::SpriteProp();
 
-		overlay->createFromImage(wind->getRenderTexture(), 1, 1);
+		overlay->createFromImage(windFront->getRenderTexture(), 1, 1);
 
 		windOverlay->getTransform().setPosition(0, 0.5f, 0)
 			.setRotation(90, 1, 0, 0);
@@ -442,21 +1004,9 @@ namespace WindSim
 	}
 
 
-	void Scene::updateEmitter(float seconds)
+	void Scene::updateEmitter()
 	{
-		auto prop = (Nova::EmitterProp*)windEmitter->getProp();
-		Nova::EmitterProp::Settings settings = prop->getSettings();
-
-		if (vEmitter != 0)
-		{
-			emitterAngle += vEmitter;
-
-			if (emitterAngle >= 360.0f)
-				emitterAngle -= 360.0f;
-
-			if (emitterAngle < 0.0f)
-				emitterAngle += 360.0f;
-		}
+		WS_PROFILE_SCOPE("Scene::updateEmitter");
 
 		float c = cosf(emitterAngle * rads);
 		float s = sinf(emitterAngle * rads);
@@ -477,20 +1027,38 @@ namespace WindSim
 		// Base particle texture colour is white, so by setting the particle colour based
 		// on the direction of travel, we can use that to decide how to affect our grass.
 		// We can also use the alpha value as the wind's power
-		if (dPower != 0)
-		{
-			power += (dPower * seconds * 0.1f);
+		// The particles' colours are stored in 8 bits a channel, and the emitter
+		// only turns a fraction of a step each frame, so most frames change nothing
+		const uint32_t colour = (static_cast<uint32_t>(s * 255.0f) << 24)
+			| (static_cast<uint32_t>(c * 255.0f) << 16)
+			| (static_cast<uint32_t>((power - 0.1f) * 255.0f) << 8)
+			| static_cast<uint32_t>((power + 0.1f) * 255.0f);
 
-			if (power < 0.1f)
-				power = 0.1f;
+		if (colour == emitterColour)
+			return;
 
-			if (power > 0.9f)
-				power = 0.9f;
-		}
+		emitterColour = colour;
 
-		settings.colourRange[0] = Colour::fromFloat(s, 0, c, power - 0.1f);
-		settings.colourRange[1] = Colour::fromFloat(s, 0, c, power + 0.1f);
+		windSettings.colourRange[0] = Colour::fromFloat(s, 0, c, power - 0.1f);
+		windSettings.colourRange[1] = Colour::fromFloat(s, 0, c, power + 0.1f);
 
-		prop->setup(settings);
+		static_cast<Nova::EmitterProp*>(windEmitter->getProp())->setup(windSettings);
+	}
+
+
+	void Scene::updatePowerText()
+	{
+		const int shown = static_cast<int>((power - 0.1f) * 100);
+
+		// Laying out the text again is only worth it when the numbers change
+		if (shown == shownPower)
+			return;
+
+		shownPower = shown;
+
+		textPower.setText("Wind Power: "
+			+ std::to_string(shown)
+			+ " to "
+			+ std::to_string(static_cast<int>((power + 0.1f) * 100)));
 	}
 }
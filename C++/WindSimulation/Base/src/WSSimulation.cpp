@@ -0,0 +1,358 @@
+/*
+ *		WSSimulation.cpp
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#include "WSSimulation.h"
+#include "WSProfile.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace WindSim
+{
+	const float Simulation::AUTO_TURN = 0.15f;
+	const float Simulation::STEP_SECONDS = 1.0f / static_cast<float>(Simulation::RATE);
+	const double Simulation::MAX_LAG = 0.25;
+
+
+	Simulation::Simulation(float emitterAngle, float power, WindField* field, Particles* particles,
+		unsigned int cells, unsigned int fieldRate, bool threaded)
+	{
+		this->field = field;
+		this->particles = field ? nullptr : particles;
+		this->cells = field ? field->getSize() : cells;
+		this->fieldRate = fieldRate;
+		this->threaded = threaded;
+
+		fieldElapsed = 0.0f;
+
+		current.emitterAngle = emitterAngle;
+		current.power = power;
+
+		if (field)
+			field->setWind(emitterAngle, power);
+
+		if (field || this->particles)
+			current.wind.assign(static_cast<size_t>(this->cells) * this->cells * 4, 0.0f);
+
+		time = 0.0;
+		target = 0.0;
+
+		turn = 0.0f;
+		dPower = 0.0f;
+		input = 0;
+		applied = 0;
+		steered = false;
+		steerAngle = emitterAngle;
+		steerPower = power;
+		scripted = false;
+		scriptAngle = emitterAngle;
+		scriptPower = power;
+
+		stopping = false;
+
+		resetPacing();
+		shownInput = 0;
+
+		// Something to show before the first step
+		states.back() = current;
+		states.publish();
+
+		if (threaded)
+			worker = std::thread(&Simulation::run, this);
+	}
+
+
+	Simulation::~Simulation()
+	{
+		if (!threaded)
+			return;
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			stopping = true;
+		}
+
+		signal.notify_all();
+
+		worker.join();
+	}
+
+
+	void Simulation::setInput(float turn, float dPower)
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			this->turn = turn;
+			this->dPower = dPower;
+
+			steered = false;
+
+			stamp();
+		}
+
+		signal.notify_all();
+	}
+
+
+	void Simulation::setSteering(float emitterAngle, float power)
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			steerAngle = emitterAngle;
+			steerPower = power;
+
+			steered = true;
+
+			stamp();
+		}
+
+		signal.notify_all();
+	}
+
+
+	void Simulation::stamp()
+	{
+		// Latency is measured from the oldest input the next step merges
+		if (input == applied)
+			inputTime = Clock::now();
+
+		input++;
+	}
+
+
+	void Simulation::setScript(float emitterAngle, float power)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		scripted = true;
+		scriptAngle = emitterAngle;
+		scriptPower = power;
+	}
+
+
+	void Simulation::frame(double seconds)
+	{
+		const Clock::time_point now = Clock::now();
+
+		if (lastFrame != Clock::time_point())
+		{
+			const double interval = std::chrono::duration<double, std::milli>(now - lastFrame).count();
+
+			intervals += interval;
+			intervalSquares += interval * interval;
+			frames++;
+		}
+
+		lastFrame = now;
+
+		std::unique_lock<std::mutex> guard(lock);
+
+		target = seconds;
+		time = std::max(time, target - MAX_LAG);
+
+		if (threaded)
+		{
+			guard.unlock();
+			signal.notify_all();
+
+			return;
+		}
+
+		// Steps whole steps up to the frame's time, on this thread
+		while (time + STEP_SECONDS <= target)
+			step(guard);
+	}
+
+
+	bool Simulation::acquire()
+	{
+		if (!states.acquire())
+			return false;
+
+		const State& state = states.front();
+
+		// Time from the input arriving to the first frame which shows it
+		if (state.input != shownInput)
+		{
+			const float latency = std::chrono::duration<float, std::milli>(Clock::now() - state.inputTime).count();
+
+			WS_PROFILE_COUNT("input latency us", latency * 1000.0f);
+
+			latencies += latency;
+			latencyCount++;
+			maxLatency = std::max(maxLatency, latency);
+
+			shownInput = state.input;
+		}
+
+		return true;
+	}
+
+
+	Simulation::Pacing Simulation::getPacing() const
+	{
+		Pacing ret;
+
+		ret.frames = frames;
+
+		if (frames > 0)
+		{
+			const double mean = intervals / frames;
+
+			ret.interval = static_cast<float>(mean);
+			ret.jitter = static_cast<float>(sqrt(std::max((intervalSquares / frames) - (mean * mean), 0.0)));
+		}
+
+		if (latencyCount > 0)
+			ret.latency = static_cast<float>(latencies / latencyCount);
+
+		ret.maxLatency = maxLatency;
+
+		return ret;
+	}
+
+
+	void Simulation::resetPacing()
+	{
+		frames = 0;
+		intervals = 0.0;
+		intervalSquares = 0.0;
+		latencies = 0.0;
+		latencyCount = 0;
+		maxLatency = 0.0f;
+	}
+
+
+	void Simulation::step(std::unique_lock<std::mutex>& guard)
+	{
+		const float stepTurn = turn;
+		const float stepPower = dPower;
+		const bool stepScripted = scripted;
+		const bool stepSteered = steered;
+		const float stepAngle = scripted ? scriptAngle : steerAngle;
+		const float stepTarget = scripted ? scriptPower : steerPower;
+
+		WS_PROFILE_COUNT("inputs per step", input - applied);
+
+		current.input = input;
+		current.inputTime = inputTime;
+
+		applied = input;
+
+		guard.unlock();
+
+		{
+			WS_PROFILE_SCOPE("Simulation::step");
+
+			if (stepScripted)
+			{
+				current.emitterAngle = stepAngle;
+				current.power = stepTarget;
+			}
+			else if (stepSteered)
+			{
+				current.emitterAngle = stepAngle;
+				current.power = std::min(std::max(stepTarget, 0.1f), 0.9f);
+			}
+			else
+			{
+				current.emitterAngle += (stepTurn != 0.0f ? stepTurn : AUTO_TURN);
+				current.power = std::min(std::max(current.power + (stepPower * STEP_SECONDS * 0.1f), 0.1f), 0.9f);
+			}
+
+			if (current.emitterAngle >= 360.0f)
+				current.emitterAngle -= 360.0f;
+
+			if (current.emitterAngle < 0.0f)
+				current.emitterAngle += 360.0f;
+
+			if (field)
+			{
+				field->setWind(current.emitterAngle, current.power);
+
+				fieldElapsed += STEP_SECONDS;
+
+				if (fieldElapsed * static_cast<float>(fieldRate) >= 1.0f)
+				{
+					field->step(fieldElapsed);
+
+					const unsigned int size = field->getSize();
+
+					for (unsigned int y = 0; y < size; y++)
+					{
+						for (unsigned int x = 0; x < size; x++)
+							field->getColour(x, y, &current.wind[((y * size) + x) * 4]);
+					}
+
+					fieldElapsed = 0.0f;
+					current.windStep++;
+				}
+			}
+			else if (particles)
+			{
+				const Clock::time_point start = Clock::now();
+
+				particles->setWind(current.emitterAngle, current.power);
+				particles->step(STEP_SECONDS);
+
+				fieldElapsed += STEP_SECONDS;
+
+				if (fieldElapsed * static_cast<float>(fieldRate) >= 1.0f)
+				{
+					particles->splat(cells, current.wind.data());
+
+					fieldElapsed = 0.0f;
+					current.windStep++;
+				}
+
+				current.particles = particles->getCount();
+				current.particleMillis = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+			}
+
+			current.step++;
+
+			// Same sizes each time, so the copy does not allocate once all three
+			// buffers have been filled
+			states.back() = current;
+			states.publish();
+		}
+
+		guard.lock();
+
+		time += STEP_SECONDS;
+	}
+
+
+	void Simulation::run()
+	{
+		std::unique_lock<std::mutex> guard(lock);
+
+		while (true)
+		{
+			// One step ahead of the next frame, so the render thread always has
+			// the step for the time it shows
+			signal.wait(guard, [this]() { return stopping || time < target + STEP_SECONDS; });
+
+			if (stopping)
+				return;
+
+			step(guard);
+		}
+	}
+}
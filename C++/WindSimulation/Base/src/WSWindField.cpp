@@ -0,0 +1,332 @@
+/*
+ *		WSWindField.cpp
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#include "WSWindField.h"
+#include "WSProfile.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace WindSim
+{
+	const float WindField::SPEED = 8.0f;
+	const float WindField::SPRING_STIFFNESS = 20.0f;
+	const float WindField::SPRING_DAMPING = 3.0f;
+
+
+	WindField::WindField(unsigned int size, uint64_t seed)
+		: random(seed)
+	{
+		const size_t cells = static_cast<size_t>(size) * size;
+
+		this->size = size;
+
+		velocityX.assign(cells, 0.0f);
+		velocityY.assign(cells, 0.0f);
+		previousX.assign(cells, 0.0f);
+		previousY.assign(cells, 0.0f);
+		pressure.assign(cells, 0.0f);
+		divergence.assign(cells, 0.0f);
+		bendX.assign(cells, 0.0f);
+		bendY.assign(cells, 0.0f);
+		swayX.assign(cells, 0.0f);
+		swayY.assign(cells, 0.0f);
+
+		directionX = 0.0f;
+		directionY = 1.0f;
+		power = 0.0f;
+
+		gust = 1.0f;
+		gustTarget = 1.0f;
+		gustTime = 0.0f;
+
+		pendingSeconds = 0.0f;
+		pending = false;
+		stopping = false;
+	}
+
+
+	WindField::~WindField()
+	{
+		if (!worker.joinable())
+			return;
+
+		{
+			std::unique_lock<std::mutex> guard(lock);
+
+			signal.wait(guard, [this]() { return !pending; });
+
+			stopping = true;
+		}
+
+		signal.notify_all();
+
+		worker.join();
+	}
+
+
+	void WindField::setWind(float angle, float power)
+	{
+		const float rads = angle * 3.14159265f / 180.0f;
+
+		// Same direction of travel as the particles fired from the emitter
+		directionX = sinf(rads);
+		directionY = cosf(rads);
+
+		this->power = power;
+	}
+
+
+	void WindField::step(float seconds)
+	{
+		if (seconds <= 0.0f)
+			return;
+
+		WS_PROFILE_SCOPE("WindField::step");
+
+		addForces(seconds);
+		advect(seconds);
+		project();
+		bend(seconds);
+	}
+
+
+	void WindField::stepAsync(float seconds)
+	{
+		// Fields stepped by their owner's thread never need a worker
+		if (!worker.joinable())
+			worker = std::thread(&WindField::run, this);
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			pendingSeconds = seconds;
+			pending = true;
+		}
+
+		signal.notify_all();
+	}
+
+
+	void WindField::wait()
+	{
+		std::unique_lock<std::mutex> guard(lock);
+
+		signal.wait(guard, [this]() { return !pending; });
+	}
+
+
+	void WindField::run()
+	{
+		std::unique_lock<std::mutex> guard(lock);
+
+		while (true)
+		{
+			signal.wait(guard, [this]() { return pending || stopping; });
+
+			if (stopping)
+				return;
+
+			// The caller leaves the field alone until wait() returns, so the step
+			// runs without holding the lock
+			guard.unlock();
+			step(pendingSeconds);
+			guard.lock();
+
+			pending = false;
+			signal.notify_all();
+		}
+	}
+
+
+	void WindField::getColour(unsigned int x, unsigned int y, float rgba[4]) const
+	{
+		const float u = bendX[index(x, y)];
+		const float v = bendY[index(x, y)];
+		const float speed = sqrtf((u * u) + (v * v));
+
+		if (speed < 0.0001f)
+		{
+			rgba[0] = 0.5f;
+			rgba[1] = 0.0f;
+			rgba[2] = 0.5f;
+			rgba[3] = 0.0f;
+
+			return;
+		}
+
+		rgba[0] = 0.5f + (0.5f * u / speed);
+		rgba[1] = 0.0f;
+		rgba[2] = 0.5f + (0.5f * v / speed);
+		rgba[3] = std::min(speed / SPEED, 1.0f);
+	}
+
+
+	float WindField::sample(const std::vector<float>& field, float x, float y) const
+	{
+		const float last = static_cast<float>(size - 1);
+
+		x = std::min(std::max(x, 0.0f), last);
+		y = std::min(std::max(y, 0.0f), last);
+
+		const auto x0 = std::min(static_cast<unsigned int>(x), size - 2);
+		const auto y0 = std::min(static_cast<unsigned int>(y), size - 2);
+		const float fx = x - static_cast<float>(x0);
+		const float fy = y - static_cast<float>(y0);
+
+		const float top = field[index(x0, y0)] + ((field[index(x0 + 1, y0)] - field[index(x0, y0)]) * fx);
+		const float bottom = field[index(x0, y0 + 1)] + ((field[index(x0 + 1, y0 + 1)] - field[index(x0, y0 + 1)]) * fx);
+
+		return top + ((bottom - top) * fy);
+	}
+
+
+	void WindField::addForces(float seconds)
+	{
+		// Gusts ease towards a new strength every so often
+		gustTime -= seconds;
+
+		if (gustTime <= 0.0f)
+		{
+			gustTarget = random.nextFloat(0.6f, 1.4f);
+			gustTime = random.nextFloat(0.5f, 2.0f);
+		}
+
+		gust += (gustTarget - gust) * std::min(seconds * 2.0f, 1.0f);
+
+		const float target = SPEED * power * gust;
+		const float ease = std::min(seconds * 4.0f, 1.0f);
+		const float damping = std::max(1.0f - (seconds * 0.2f), 0.0f);
+		const float half = static_cast<float>(size) / 2.0f;
+
+		for (unsigned int y = 0; y < size; y++)
+		{
+			const float py = (static_cast<float>(y) + 0.5f - half) / half;
+
+			for (unsigned int x = 0; x < size; x++)
+			{
+				const float px = (static_cast<float>(x) + 0.5f - half) / half;
+				const size_t cell = index(x, y);
+
+				// Cells along the upwind edges are pushed in the wind's direction,
+				// each a little differently so the front is not a straight line
+				if ((px * directionX) + (py * directionY) < -0.6f)
+				{
+					const float strength = target * random.nextFloat(0.8f, 1.2f);
+
+					velocityX[cell] += ((directionX * strength) - velocityX[cell]) * ease;
+					velocityY[cell] += ((directionY * strength) - velocityY[cell]) * ease;
+				}
+				else
+				{
+					velocityX[cell] *= damping;
+					velocityY[cell] *= damping;
+				}
+			}
+		}
+	}
+
+
+	void WindField::advect(float seconds)
+	{
+		previousX.swap(velocityX);
+		previousY.swap(velocityY);
+
+		// Each cell takes the velocity from where its air was a step ago
+		for (unsigned int y = 0; y < size; y++)
+		{
+			for (unsigned int x = 0; x < size; x++)
+			{
+				const size_t cell = index(x, y);
+				const float fromX = static_cast<float>(x) - (previousX[cell] * seconds);
+				const float fromY = static_cast<float>(y) - (previousY[cell] * seconds);
+
+				velocityX[cell] = sample(previousX, fromX, fromY);
+				velocityY[cell] = sample(previousY, fromX, fromY);
+			}
+		}
+	}
+
+
+	void WindField::project()
+	{
+		const unsigned int last = size - 1;
+
+		// Pressure is zero outside the field, so air can flow out of the edges
+		auto at = [&](const std::vector<float>& field, unsigned int x, unsigned int y, int dx, int dy)
+		{
+			if ((dx < 0 && x == 0) || (dx > 0 && x == last) || (dy < 0 && y == 0) || (dy > 0 && y == last))
+				return 0.0f;
+
+			return field[index(x + dx, y + dy)];
+		};
+
+		for (unsigned int y = 0; y < size; y++)
+		{
+			for (unsigned int x = 0; x < size; x++)
+			{
+				divergence[index(x, y)] = -0.5f * (at(velocityX, x, y, 1, 0) - at(velocityX, x, y, -1, 0)
+					+ at(velocityY, x, y, 0, 1) - at(velocityY, x, y, 0, -1));
+			}
+		}
+
+		std::fill(pressure.begin(), pressure.end(), 0.0f);
+
+		// Jacobi iterations, ping-ponging with the advection buffer, which is free
+		// until the next step
+		std::vector<float>& next = previousX;
+
+		for (unsigned int i = 0; i < PRESSURE_ITERATIONS; i++)
+		{
+			for (unsigned int y = 0; y < size; y++)
+			{
+				for (unsigned int x = 0; x < size; x++)
+				{
+					next[index(x, y)] = (divergence[index(x, y)]
+						+ at(pressure, x, y, -1, 0) + at(pressure, x, y, 1, 0)
+						+ at(pressure, x, y, 0, -1) + at(pressure, x, y, 0, 1)) * 0.25f;
+				}
+			}
+
+			pressure.swap(next);
+		}
+
+		for (unsigned int y = 0; y < size; y++)
+		{
+			for (unsigned int x = 0; x < size; x++)
+			{
+				velocityX[index(x, y)] -= 0.5f * (at(pressure, x, y, 1, 0) - at(pressure, x, y, -1, 0));
+				velocityY[index(x, y)] -= 0.5f * (at(pressure, x, y, 0, 1) - at(pressure, x, y, 0, -1));
+			}
+		}
+	}
+
+
+	void WindField::bend(float seconds)
+	{
+		const size_t cells = bendX.size();
+
+		// Semi-implicit Euler, which stays stable at the wind's update rate
+		for (size_t cell = 0; cell < cells; cell++)
+		{
+			swayX[cell] += ((SPRING_STIFFNESS * (velocityX[cell] - bendX[cell])) - (SPRING_DAMPING * swayX[cell])) * seconds;
+			swayY[cell] += ((SPRING_STIFFNESS * (velocityY[cell] - bendY[cell])) - (SPRING_DAMPING * swayY[cell])) * seconds;
+
+			bendX[cell] += swayX[cell] * seconds;
+			bendY[cell] += swayY[cell] * seconds;
+		}
+	}
+}
@@ -22,11 +22,12 @@
 
 #include "WSFinalScene.h"
 
-namespace WindSim::Windows
+namespace WindSim::Desktop
 {
 
 	/**
-	 *	Application class for the Wind Simulation project for Windows
+	 *	Application class for the Wind Simulation project on the desktop, for
+	 *	Windows and Linux (through GLFW)
 	 */
 	class App : public Nova::GL::GLFWApp
 	{
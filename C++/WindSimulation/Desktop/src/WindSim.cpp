@@ -18,12 +18,12 @@
 
 #include "WindSim.h"
 
+#include <GLFW/glfw3.h>
+
 using Nova::Colour;
 using Nova::Math::Matrix;
 
-using std::string;
-
-namespace WindSim::Windows
+namespace WindSim::Desktop
 {
 	App::App(int argc, char** argv)
 	{
@@ -47,7 +47,9 @@ namespace WindSim::Windows
 
 int main(int argc, char** argv)
 {
+#if defined(_WIN32)
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+#endif
 
 	Nova::App::WindowSettings settings;
 
@@ -55,13 +57,14 @@ int main(int argc, char** argv)
 	settings.height = 800;
 	settings.title = "Wind Sim by Chris Allen - Powered by Nova";
 
-	Nova::App::open(DBG_NEW WindSim::Windows::App(argc, argv), settings);
-
-	Nova::App::getSceneManager().putScene("MAIN_SCENE", Nova::Scene_p(DBG_NEW WindSim::FinalScene()));
+	const WindSim::LaunchSettings launch = WindSim::parseArguments(argc, argv);
 
-	Nova::App::getContext()->loadDefaultFont("Montserrat-Regular.ttf");
+	Nova::App::open(DBG_NEW WindSim::Desktop::App(argc, argv), settings);
 
-	Nova::App::start("MAIN_SCENE");
-
-	return 0;
+	// A finished benchmark closes the window, so the App shuts down as it does
+	// when the user closes it
+	return WindSim::FinalScene::start(launch, []()
+	{
+		glfwSetWindowShouldClose(glfwGetCurrentContext(), GLFW_TRUE);
+	});
 }
@@ -0,0 +1,167 @@
+/*
+ *		WindSimHeadless.cpp
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+/*
+ *	Runs the parts of the simulation which don't need Nova, without a window,
+ *	so they can be benchmarked on a Linux server or CI machine.  Takes the same
+ *	options as the App; -benchmark sets the number of frames.
+ *
+ *	First the CPU wind (or with -cpuparticles, the CPU particles) and the
+ *	scripted wind are stepped through Benchmark's timeline on one thread, timing
+ *	each frame.  Then the simulation runs on its
+ *	own thread in real time, at 60 frames a second, with input every half
+ *	second, to measure the frame jitter and input latency.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <thread>
+
+#include "WSBenchmark.h"
+#include "WSLaunch.h"
+#include "WSSimulation.h"
+
+namespace
+{
+	const char* REPORT = "windsim_headless.txt";
+
+	/**
+	 *	Frames run in real time, for the pacing figures
+	 */
+	const unsigned int PACED_FRAMES = 300;
+
+	/**
+	 *	Same field as the Scene's WIND_CELLS and WIND_RATE, which can't be used
+	 *	here without Nova
+	 */
+	const unsigned int WIND_CELLS = 20;
+	const unsigned int WIND_RATE = 30;
+
+	/**
+	 *	CPU wind field or particles, as the settings ask for, set up as the
+	 *	Scene sets them up
+	 */
+	struct Wind
+	{
+		std::unique_ptr<WindSim::WindField> field;
+		std::unique_ptr<WindSim::Particles> particles;
+
+		explicit Wind(const WindSim::LaunchSettings& launch)
+		{
+			if (launch.cpuParticles)
+			{
+				WindSim::Particles::Settings settings;
+
+				settings.maxParticles = 100000;
+				settings.emitters = launch.gusts;
+
+				particles = std::make_unique<WindSim::Particles>(settings, launch.seed);
+			}
+			else
+				field = std::make_unique<WindSim::WindField>(WIND_CELLS, launch.seed);
+		}
+
+		std::unique_ptr<WindSim::Simulation> createSimulation(bool threaded)
+		{
+			return std::make_unique<WindSim::Simulation>(
+				90.0f, 0.9f, field.get(), particles.get(), WIND_CELLS, WIND_RATE, threaded);
+		}
+	};
+}
+
+
+int main(int argc, char** argv)
+{
+	WindSim::LaunchSettings launch = WindSim::parseArguments(argc, argv);
+
+	if (launch.benchmarkFrames == 0)
+		launch.benchmarkFrames = 1000;
+
+	// Particles stepped, and the time taken, for the particles' throughput
+	double particles = 0.0;
+	double particleMillis = 0.0;
+
+	{
+		Wind wind(launch);
+		std::unique_ptr<WindSim::Simulation> simulation = wind.createSimulation(false);
+		WindSim::Benchmark benchmark(launch.benchmarkFrames, REPORT);
+
+		double time = 0.0;
+		uint64_t step = 0;
+
+		while (!benchmark.isFinished())
+		{
+			benchmark.beginFrame();
+
+			const WindSim::Benchmark::Frame script = WindSim::Benchmark::getScript(benchmark.getFrame());
+
+			time += static_cast<double>(WindSim::Benchmark::STEP) / 1000.0;
+
+			simulation->setScript(script.emitterAngle, script.power);
+			simulation->frame(time);
+
+			if (simulation->acquire() && simulation->getState().step != step)
+			{
+				step = simulation->getState().step;
+
+				particles += simulation->getState().particles;
+				particleMillis += simulation->getState().particleMillis;
+			}
+
+			benchmark.mark(WindSim::Benchmark::PHYSICS);
+			benchmark.endFrame();
+		}
+
+		if (!benchmark.writeReport())
+			return 1;
+	}
+
+	Wind wind(launch);
+	std::unique_ptr<WindSim::Simulation> simulation = wind.createSimulation(true);
+
+	const auto start = WindSim::Simulation::Clock::now();
+	const auto frame = std::chrono::microseconds(1000000 / 60);
+
+	for (unsigned int i = 1; i <= PACED_FRAMES; i++)
+	{
+		if (i % 30 == 0)
+			simulation->setInput((i / 30) % 2 == 0 ? 1.0f : -1.0f, 0.0f);
+
+		simulation->frame(static_cast<double>(i) / 60.0);
+		simulation->acquire();
+
+		std::this_thread::sleep_until(start + (frame * i));
+	}
+
+	const WindSim::Simulation::Pacing pacing = simulation->getPacing();
+
+	std::ofstream file(REPORT, std::ios::app);
+
+	if (!file.is_open())
+		return 1;
+
+	file << std::fixed << std::setprecision(3)
+		<< "\nPaced run: " << pacing.frames << " frames, " << pacing.interval << "ms apart, jitter "
+		<< pacing.jitter << "ms, input latency " << pacing.latency << "ms (worst " << pacing.maxLatency << "ms)\n";
+
+	if (particleMillis > 0.0)
+		file << "Particles: " << static_cast<long>(particles / particleMillis) << " per ms\n";
+
+	file.close();
+
+	return file.fail() ? 1 : 0;
+}
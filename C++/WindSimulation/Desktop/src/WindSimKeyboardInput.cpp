@@ -1,5 +1,5 @@
 /*
- *		WindSimWindowsInputHandler.cpp
+ *		WindSimKeyboardInput.cpp
  *
  *	Author: Chris Allen
  *	Date: 29-July-18
@@ -57,7 +57,9 @@ namespace WindSim
 			return false;
 		}
 
-		eUpdate = true;
+		// Applied by the simulation's next step
+		if (simulation)
+			simulation->setInput(vEmitter, dPower);
 
 		return true;
 	}
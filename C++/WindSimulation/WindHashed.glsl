@@ -0,0 +1,129 @@
+#version 430
+
+/*
+ *		WindHashed.glsl
+ *
+ *	Author: Chris Allen
+ *	Copyright Chris Allen 2018, all rights reserved
+ *
+ *	This file forms part of the Wind Simulation Project.
+ *	It is intended to form part of my portfolio, for demonstration purposes ONLY.
+ *
+ *	You may NOT edit/alter this file in any way.
+ *	You may NOT make any copies of this file for purposes other than its original intention (i.e. for demonstration purposes).
+ *	You may NOT use or claim this file as your own work, either partially or wholly
+ *
+ *	This file is provided as-is.  No support will be provided for editing or using this file beyond its original intention.
+ */
+
+#ifdef COMPILE_VS
+
+/*
+ *	Each vertex holds the base position of its blade in x and z.  The y holds
+ *	the blade's random key in its upper 16 bits, how far up the blade the vertex
+ *	is in 60ths in the next 7, and which side of the blade it is on in the
+ *	lowest bit.  The same shader draws every level of detail.
+ */
+layout (location = 0) in vec3 vertex;
+layout (location = 1) in vec2 uv;
+
+uniform mat4 model;
+
+layout( std140 ) uniform Camera
+{
+	mat4 view;
+	mat4 projection;
+};
+
+uniform sampler2D image;
+
+out vec2 texCoord;
+out float delta;
+
+uint hash(uint x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352du;
+	x ^= x >> 15;
+	x *= 0x846ca68bu;
+	x ^= x >> 16;
+
+	return x;
+}
+
+// Next random value in [0, 1) from the blade's key
+float nextFloat(inout uint state)
+{
+	state = hash(state + 0x9e3779b9u);
+
+	return float(state >> 8) / 16777216.0;
+}
+
+void main()
+{
+	mat4 mvp = projection * view * model;
+
+	uint packed = uint(vertex.y);
+	uint side = packed & 1u;
+	uint rise = (packed >> 1) & 127u;
+	uint state = packed >> 8;
+
+	// Same ranges as FinalScene::setupBlade()
+	float bHeight = mix(0.5, 1.0, nextFloat(state));
+	float bWidth = mix(0.5, 1.0, nextFloat(state));
+	float angle = radians(mix(-55.0, 55.0, nextFloat(state)));
+	float offset = mix(-0.25, 0.25, nextFloat(state));
+
+	// Top of the blade is at twice its height, before it is scaled
+	float across = (side == 0u ? -0.15 : 0.15) * bWidth;
+	float height = 2.0 * bHeight * (float(rise) / 60.0) * bHeight;
+
+	vec3 blade = vec3(	vertex.x + offset + (across * cos(angle)),
+						height,
+						vertex.z + offset - (across * sin(angle)));
+
+	vec4 colour = texture(image, uv);
+
+	texCoord = uv;
+
+	delta = blade.y / 2.0;
+
+	if(colour.a > 0.0)
+	{
+		float power = colour.a * 2.0;
+
+		float deltaS = blade.y * blade.y * 0.5;
+
+		vec3 displacement = vec3(	power * (colour.r - 0.5),
+									power * (colour.g - 0.5),
+									power * (colour.b - 0.5));
+
+		vec3 position = vec3(	blade.x + (displacement.x * deltaS),
+								blade.y,
+								blade.z - (displacement.z * deltaS));
+
+		gl_Position = mvp * vec4(position, 1.0);
+	}
+	else
+		gl_Position = mvp * vec4(blade, 1.0);
+}
+
+#endif
+
+#ifdef COMPILE_FS
+
+
+uniform vec4 colour = vec4(0, 0.75, 0, 1);
+uniform vec4 transMask = vec4(0, 0, 0, 0);
+
+in vec2 texCoord;
+in float delta;
+
+out vec4 FragColour;
+
+void main()
+{
+	FragColour = vec4(colour.r, colour.g * delta, colour.b, colour.a);
+}
+
+#endif